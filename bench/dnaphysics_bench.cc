@@ -0,0 +1,350 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file dnaphysics_bench.cc
+/// \brief Benchmark driver running the bench/*.in scenarios at several thread counts
+
+// Usage: dnaphysics_bench [-x dnaphysics] [-d scenarioDir] [-t threads]
+//                         [-o results.json] [-b baseline.json] [-r tolerance]
+//                         [scenario ...]
+//
+// Runs "dnaphysics <scenario>.in <threads>" for each scenario (all the .in
+// files of scenarioDir by default, "bench") and each thread count, in its own
+// directory bench_runs/<scenario>_t<threads>, and reports for each run:
+//  - the initialization time and the events and steps per second, parsed from
+//    the "--- Run:" line printed by the master at the end of each run,
+//  - the bytes written in the run directory,
+//  - the peak resident memory of the process (wait4).
+// -t N runs 1, 2, 4, ... and N threads; -t 1,3,8 runs the listed counts
+// (default: up to the number of cores).
+// The results are written as one JSON object per line (-o, default
+// bench_results.json). With -b, the events per second are compared with a
+// previous results file, and the program exits with status 1 if a run is
+// slower than the baseline by more than the tolerance (-r, default 0.1).
+// This program does not depend on Geant4.
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+struct Result
+{
+    std::string scenario;
+    int threads = 1;
+    int status = 0;
+    double initTime = 0.;  // seconds
+    double runTime = 0.;  // seconds, sum over the runs of the macro
+    double wallTime = 0.;  // seconds, whole process
+    long events = 0;
+    long steps = 0;
+    std::uintmax_t bytes = 0;
+    long peakRss = 0;  // kB
+
+    double EventsPerSecond() const { return runTime > 0. ? events / runTime : 0.; }
+    double StepsPerSecond() const { return runTime > 0. ? steps / runTime : 0.; }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<int> ThreadCounts(const std::string& option)
+{
+  std::vector<int> counts;
+  if (option.find(',') != std::string::npos) {
+    std::istringstream tokens(option);
+    std::string token;
+    while (std::getline(tokens, token, ',')) {
+      counts.push_back(std::max(1, std::atoi(token.c_str())));
+    }
+    return counts;
+  }
+
+  int maxThreads = std::max(1, std::atoi(option.c_str()));
+  for (int n = 1; n < maxThreads; n *= 2) {
+    counts.push_back(n);
+  }
+  counts.push_back(maxThreads);
+  return counts;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ParseLog(const fs::path& log, Result& result)
+{
+  // --- Run: events <n> steps <n> init <s> s run <s> s
+  std::ifstream input(log);
+  std::string line;
+  bool first = true;
+  while (std::getline(input, line)) {
+    if (line.rfind("--- Run:", 0) != 0) continue;
+    std::istringstream tokens(line.substr(8));
+    std::string key, unit;
+    long events = 0, steps = 0;
+    double init = 0., run = 0.;
+    tokens >> key >> events >> key >> steps >> key >> init >> unit >> key >> run;
+    result.events += events;
+    result.steps += steps;
+    result.runTime += run;
+    if (first) result.initTime = init;
+    first = false;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::uintmax_t DirectorySize(const fs::path& directory)
+{
+  std::uintmax_t bytes = 0;
+  for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+    if (entry.is_regular_file() && entry.path().filename() != "run.log") {
+      bytes += entry.file_size();
+    }
+  }
+  return bytes;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+Result Run(const fs::path& executable, const fs::path& macro, int threads)
+{
+  Result result;
+  result.scenario = macro.stem().string();
+  result.threads = threads;
+
+  // Fresh directory for the output files of the run
+  fs::path directory =
+    fs::path("bench_runs") / (result.scenario + "_t" + std::to_string(threads));
+  fs::remove_all(directory);
+  fs::create_directories(directory);
+
+  std::string threadArgument = std::to_string(threads);
+  auto start = std::chrono::steady_clock::now();
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    if (chdir(directory.c_str()) != 0) _exit(127);
+    int log = open("run.log", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (log < 0) _exit(127);
+    dup2(log, STDOUT_FILENO);
+    dup2(log, STDERR_FILENO);
+    close(log);
+    execl(executable.c_str(), executable.c_str(), macro.c_str(), threadArgument.c_str(),
+          (char*)nullptr);
+    _exit(127);
+  }
+  if (pid < 0) {
+    result.status = -1;
+    return result;
+  }
+
+  int status = 0;
+  struct rusage usage;
+  std::memset(&usage, 0, sizeof(usage));
+  wait4(pid, &status, 0, &usage);
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  result.wallTime = elapsed.count();
+  result.status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+  result.peakRss = usage.ru_maxrss;  // kB on Linux
+
+  ParseLog(directory / "run.log", result);
+  result.bytes = DirectorySize(directory);
+  return result;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::string ToJson(const Result& result)
+{
+  std::ostringstream json;
+  json << std::setprecision(9);
+  json << "{\"scenario\": \"" << result.scenario << "\", \"threads\": " << result.threads
+       << ", \"status\": " << result.status << ", \"init_s\": " << result.initTime
+       << ", \"run_s\": " << result.runTime << ", \"wall_s\": " << result.wallTime
+       << ", \"events\": " << result.events << ", \"steps\": " << result.steps
+       << ", \"events_per_s\": " << result.EventsPerSecond()
+       << ", \"steps_per_s\": " << result.StepsPerSecond() << ", \"bytes\": " << result.bytes
+       << ", \"peak_rss_kb\": " << result.peakRss << "}";
+  return json.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Value of "key" in one line written by ToJson
+std::string JsonValue(const std::string& line, const std::string& key)
+{
+  std::string pattern = "\"" + key + "\": ";
+  std::size_t begin = line.find(pattern);
+  if (begin == std::string::npos) return "";
+  begin += pattern.size();
+  std::size_t end = line.find_first_of(",}", begin);
+  std::string value = line.substr(begin, end - begin);
+  value.erase(std::remove(value.begin(), value.end(), '"'), value.end());
+  return value;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Events per second of each (scenario, threads) of a results file
+std::map<std::pair<std::string, int>, double> ReadBaseline(const std::string& path)
+{
+  std::map<std::pair<std::string, int>, double> baseline;
+  std::ifstream input(path);
+  std::string line;
+  while (std::getline(input, line)) {
+    std::string scenario = JsonValue(line, "scenario");
+    if (scenario.empty()) continue;
+    int threads = std::atoi(JsonValue(line, "threads").c_str());
+    baseline[{scenario, threads}] = std::atof(JsonValue(line, "events_per_s").c_str());
+  }
+  return baseline;
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  std::string executable = "./dnaphysics";
+  std::string scenarioDirectory = "bench";
+  std::string threadOption = std::to_string(std::max(1u, std::thread::hardware_concurrency()));
+  std::string outputPath = "bench_results.json";
+  std::string baselinePath;
+  double tolerance = 0.1;
+  std::vector<std::string> names;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string option = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (option == "-x" && hasValue) executable = argv[++i];
+    else if (option == "-d" && hasValue) scenarioDirectory = argv[++i];
+    else if (option == "-t" && hasValue) threadOption = argv[++i];
+    else if (option == "-o" && hasValue) outputPath = argv[++i];
+    else if (option == "-b" && hasValue) baselinePath = argv[++i];
+    else if (option == "-r" && hasValue) tolerance = std::atof(argv[++i]);
+    else names.push_back(option);
+  }
+
+  // The runs are done in their own directories
+  fs::path executablePath = fs::absolute(executable);
+  if (!fs::exists(executablePath)) {
+    std::cerr << "dnaphysics_bench: cannot find " << executablePath << std::endl;
+    return 1;
+  }
+
+  std::vector<fs::path> macros;
+  if (names.empty()) {
+    for (const auto& entry : fs::directory_iterator(scenarioDirectory)) {
+      if (entry.path().extension() == ".in") macros.push_back(fs::absolute(entry.path()));
+    }
+    std::sort(macros.begin(), macros.end());
+  }
+  else {
+    for (const auto& name : names) {
+      fs::path macro = fs::path(scenarioDirectory) / (fs::path(name).stem().string() + ".in");
+      macros.push_back(fs::absolute(macro));
+    }
+  }
+  if (macros.empty()) {
+    std::cerr << "dnaphysics_bench: no scenario in " << scenarioDirectory << std::endl;
+    return 1;
+  }
+
+  auto baseline = ReadBaseline(baselinePath);
+  std::ofstream output(outputPath);
+  int exitCode = 0;
+
+  std::cout << std::left << std::setw(18) << "scenario" << std::right << std::setw(8) << "threads"
+            << std::setw(10) << "init (s)" << std::setw(12) << "events/s" << std::setw(12)
+            << "steps/s" << std::setw(14) << "bytes" << std::setw(12) << "RSS (kB)"
+            << std::setw(10) << "baseline" << std::endl;
+
+  for (const auto& macro : macros) {
+    for (int threads : ThreadCounts(threadOption)) {
+      Result result = Run(executablePath, macro, threads);
+      output << ToJson(result) << '\n';
+      output.flush();
+
+      std::cout << std::left << std::setw(18) << result.scenario << std::right << std::setw(8)
+                << threads << std::setw(10) << std::setprecision(3) << result.initTime
+                << std::setw(12) << std::setprecision(4) << result.EventsPerSecond()
+                << std::setw(12) << result.StepsPerSecond() << std::setw(14) << result.bytes
+                << std::setw(12) << result.peakRss;
+
+      if (result.status != 0 || result.events == 0) {
+        std::cout << "  FAILED (status " << result.status << ", see bench_runs)" << std::endl;
+        exitCode = 1;
+        continue;
+      }
+
+      auto reference = baseline.find({result.scenario, threads});
+      if (reference != baseline.end() && reference->second > 0.) {
+        double ratio = result.EventsPerSecond() / reference->second;
+        std::cout << std::setw(9) << std::setprecision(3) << ratio << 'x';
+        if (ratio < 1. - tolerance) {
+          std::cout << "  REGRESSION";
+          exitCode = 1;
+        }
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  std::cout << "Results written to " << outputPath << std::endl;
+  return exitCode;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
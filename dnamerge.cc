@@ -0,0 +1,315 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file dnamerge.cc
+/// \brief Offline merge of the per-thread dnaphysics output shards
+
+// Usage: dnamerge [-j threads] [manifest]
+//
+// Reads the manifest written by the master thread (dna.manifest by default)
+// when ntuple merging is disabled or the columnar format is used.
+//  - columnar: every column of every table is concatenated over the shards
+//    into <name>.columns/<table>/<column>.col; columns are merged in parallel
+//    into <table>_merging, renamed to <table> once complete. A manifest
+//    without a step table for its shards is an error.
+//  - root: the shards, together with the master files listed in the
+//    manifest (histograms and meta ntuple), are merged with "hadd -j" into a
+//    temporary file renamed to <name>.root once complete.
+// This program does not depend on Geant4.
+
+#include "ColumnFormat.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+struct Manifest
+{
+    std::string name = "dna";
+    std::string format = "root";
+    std::vector<std::string> suffixes;
+    std::vector<std::string> masters;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool ReadManifest(const std::string& path, Manifest& manifest)
+{
+  std::ifstream input(path);
+  if (!input) return false;
+
+  std::string line;
+  while (std::getline(input, line)) {
+    std::istringstream tokens(line);
+    std::string key;
+    tokens >> key;
+    if (key == "name") tokens >> manifest.name;
+    if (key == "format") tokens >> manifest.format;
+    if (key == "shard") {
+      int threadID = 0, events = 0;
+      std::string suffix;
+      tokens >> threadID >> events >> suffix;
+      manifest.suffixes.push_back(suffix);
+    }
+    if (key == "master") {
+      std::string file;
+      tokens >> file;
+      manifest.masters.push_back(file);
+    }
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+struct ColumnJob
+{
+    std::vector<std::string> inputs;
+    std::string output;
+};
+
+// Concatenates the data of the input column files; returns the row count
+// or -1 on error
+long long MergeColumn(const ColumnJob& job)
+{
+  std::FILE* out = std::fopen(job.output.c_str(), "wb");
+  if (out == nullptr) {
+    std::cerr << "dnamerge: cannot open " << job.output << std::endl;
+    return -1;
+  }
+
+  std::vector<char> buffer(1 << 22);
+  ColumnHeader merged;
+  std::uint64_t rows = 0;
+
+  for (std::size_t i = 0; i < job.inputs.size(); ++i) {
+    std::FILE* in = std::fopen(job.inputs[i].c_str(), "rb");
+    ColumnHeader header;
+    if (in == nullptr || std::fread(&header, sizeof(header), 1, in) != 1
+        || std::memcmp(header.magic, kColumnMagic, sizeof(header.magic)) != 0)
+    {
+      std::cerr << "dnamerge: not a column file: " << job.inputs[i] << std::endl;
+      if (in != nullptr) std::fclose(in);
+      std::fclose(out);
+      return -1;
+    }
+
+    if (i == 0) {
+      merged = header;
+      std::fwrite(&merged, sizeof(merged), 1, out);
+    }
+    else if (header.type != merged.type) {
+      std::cerr << "dnamerge: column type mismatch in " << job.inputs[i] << std::endl;
+      std::fclose(in);
+      std::fclose(out);
+      return -1;
+    }
+
+    std::size_t n;
+    while ((n = std::fread(buffer.data(), 1, buffer.size(), in)) > 0) {
+      std::fwrite(buffer.data(), 1, n, out);
+    }
+    rows += header.rows;
+    std::fclose(in);
+  }
+
+  std::fseek(out, (long)kColumnRowsOffset, SEEK_SET);
+  std::fwrite(&rows, sizeof(rows), 1, out);
+  std::fclose(out);
+  return (long long)rows;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int MergeColumnar(const Manifest& manifest, unsigned nThreads)
+{
+  // Tables are merged into <table>_merging, which then replaces <table>: a
+  // sequential run has its only shard in <table> itself (empty suffix)
+  std::string base = manifest.name + ".columns/";
+  std::vector<std::string> tables;
+  std::vector<std::string> outputs;
+  std::vector<ColumnJob> jobs;
+
+  for (const char* table : {"step", "track", "meta", "cluster"}) {
+    fs::path first = base + table + manifest.suffixes.front();
+    if (!fs::is_directory(first)) continue;
+
+    std::string merging = base + table + "_merging";
+    fs::remove_all(merging);
+    fs::create_directories(merging);
+    tables.push_back(table);
+    for (const auto& entry : fs::directory_iterator(first)) {
+      if (entry.path().extension() != ".col") continue;
+      std::string column = entry.path().filename().string();
+
+      ColumnJob job;
+      for (const auto& suffix : manifest.suffixes) {
+        job.inputs.push_back(base + table + suffix + "/" + column);
+      }
+      job.output = merging + "/" + column;
+      jobs.push_back(job);
+      outputs.push_back(base + table + "/" + column);
+    }
+  }
+  if (tables.empty() || tables.front() != "step") {
+    std::cerr << "dnamerge: no step table " << base << "step" << manifest.suffixes.front()
+              << " for the shards listed" << std::endl;
+    return 1;
+  }
+
+  std::atomic<std::size_t> next(0);
+  std::atomic<bool> failed(false);
+  std::vector<long long> rows(jobs.size(), 0);
+
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < nThreads; ++t) {
+    workers.emplace_back([&]() {
+      for (std::size_t i = next++; i < jobs.size(); i = next++) {
+        rows[i] = MergeColumn(jobs[i]);
+        if (rows[i] < 0) failed = true;
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (const auto& table : tables) {
+    std::string merging = base + table + "_merging";
+    if (failed) {
+      fs::remove_all(merging);
+      continue;
+    }
+    fs::remove_all(base + table);
+    fs::rename(merging, base + table);
+  }
+  if (failed) return 1;
+
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    std::cout << outputs[i] << ": " << rows[i] << " rows" << std::endl;
+  }
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int MergeRoot(const Manifest& manifest, unsigned nThreads)
+{
+  // The master files are inputs too: the output is written aside, then
+  // replaces <name>.root
+  std::string output = manifest.name + ".root";
+  std::string merging = manifest.name + "_merging.root";
+
+  std::vector<std::string> inputs;
+  for (const auto& suffix : manifest.suffixes) {
+    inputs.push_back(manifest.name + suffix + ".root");
+  }
+  for (const auto& master : manifest.masters) {
+    // Sequential runs have their only shard in the master file
+    if (std::find(inputs.begin(), inputs.end(), master) == inputs.end()) {
+      inputs.push_back(master);
+    }
+  }
+
+  std::string command = "hadd -f -j " + std::to_string(nThreads) + " " + merging;
+  for (const auto& input : inputs) {
+    command += " " + input;
+  }
+  std::cout << command << std::endl;
+  if (std::system(command.c_str()) != 0) return 1;
+
+  std::error_code error;
+  fs::rename(merging, output, error);
+  if (error) {
+    std::cerr << "dnamerge: cannot rename " << merging << " to " << output << ": "
+              << error.message() << std::endl;
+    return 1;
+  }
+  std::cout << output << ": merged from " << inputs.size() << " files" << std::endl;
+  return 0;
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  std::string manifestPath = "dna.manifest";
+  unsigned nThreads = std::thread::hardware_concurrency();
+  if (nThreads == 0) nThreads = 1;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+      nThreads = std::max(1, std::atoi(argv[++i]));
+    }
+    else {
+      manifestPath = argv[i];
+    }
+  }
+
+  Manifest manifest;
+  if (!ReadManifest(manifestPath, manifest)) {
+    std::cerr << "dnamerge: cannot read manifest " << manifestPath << std::endl;
+    return 1;
+  }
+  if (manifest.suffixes.empty()) {
+    std::cerr << "dnamerge: no shard listed in " << manifestPath << std::endl;
+    return 1;
+  }
+
+  try {
+    if (manifest.format == "columnar") return MergeColumnar(manifest, nThreads);
+    return MergeRoot(manifest, nThreads);
+  }
+  catch (const fs::filesystem_error& error) {
+    std::cerr << "dnamerge: " << error.what() << std::endl;
+    return 1;
+  }
+}
@@ -39,29 +39,85 @@
 #include "ActionInitialization.hh"
 #include "DetectorConstruction.hh"
 #include "PhysicsList.hh"
+#include "ShardLauncher.hh"
 
+#include "G4MTRunManager.hh"
 #include "G4RunManagerFactory.hh"
+#include "G4Threading.hh"
 #include "G4Types.hh"
 #include "G4UIExecutive.hh"
 #include "G4UImanager.hh"
 #include "G4VisExecutive.hh"
 
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 int main(int argc, char** argv)
 {
+  // --resume: continue the interrupted run of dna.checkpoint (see Checkpoint)
+  // --shards N [--seed S]: run the macro in N processes (see ShardLauncher)
+  // --shard k N S: process k of a sharded run (set by the launcher)
+  G4bool resume = false;
+  G4int nofShards = 0;
+  std::uint64_t shardSeed = 0;
+  G4String shardSelection;
+  std::vector<char*> arguments;
+  for (G4int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--resume") == 0) {
+      resume = true;
+    }
+    else if (std::strcmp(argv[i], "--shards") == 0 && i + 1 < argc) {
+      nofShards = atoi(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      shardSeed = std::strtoull(argv[++i], nullptr, 0);
+    }
+    else if (std::strcmp(argv[i], "--shard") == 0 && i + 3 < argc) {
+      shardSelection = G4String(argv[i + 1]) + " " + argv[i + 2] + " " + argv[i + 3];
+      i += 3;
+    }
+    else {
+      arguments.push_back(argv[i]);
+    }
+  }
+
+  if (nofShards > 0) {
+    std::vector<std::string> launcherArguments(arguments.begin(), arguments.end());
+    if (resume) launcherArguments.emplace_back("--resume");
+    ShardLauncher launcher(nofShards, shardSeed);
+    return launcher.Run(launcherArguments);
+  }
+
+  argc = (G4int)arguments.size();
+  argv = arguments.data();
+
   // Detect interactive mode (if no arguments) and define UI session
   G4UIExecutive* ui = nullptr;
   if (argc == 1) {
     ui = new G4UIExecutive(argc, argv);
   }
 
-  // Construct the default run manager
-  auto* runManager = G4RunManagerFactory::CreateRunManager();
-  if (argc == 3)
-    runManager->SetNumberOfThreads(atoi(argv[2]));
-  else
-    runManager->SetNumberOfThreads(2);
+  // Construct the task-based run manager (sequential if Geant4 is built
+  // without multithreading): the events are processed in tasks taken by the
+  // free threads of the pool, which balances events of very different costs
+  auto* runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Tasking, false);
+
+  // Usage: dnaphysics [macro [threads [eventsPerTask]]] [--resume]
+  //                   [--shards N [--seed S]]
+  // By default one thread per core and the Geant4 events per task
+  // (square root of the number of events)
+  G4int nThreads = (argc >= 3) ? atoi(argv[2]) : 0;
+  if (nThreads <= 0) nThreads = G4Threading::G4GetNumberOfCores();
+  runManager->SetNumberOfThreads(nThreads);
+
+  auto mtRunManager = dynamic_cast<G4MTRunManager*>(runManager);
+  if (argc >= 4 && mtRunManager != nullptr) {
+    mtRunManager->SetEventModulo(atoi(argv[3]));
+  }
 
   // Set mandatory user initialization classes
   auto physlist = new PhysicsList();
@@ -76,6 +132,8 @@ int main(int argc, char** argv)
 
   // Get the pointer to the User Interface manager
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
+  if (!shardSelection.empty()) UImanager->ApplyCommand("/dna/shard/select " + shardSelection);
+  if (resume) UImanager->ApplyCommand("/dna/checkpoint/resume");
   if (nullptr == ui) {
     // Batch mode
     G4String command = "/control/execute ";
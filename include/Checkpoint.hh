@@ -0,0 +1,140 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file Checkpoint.hh
+/// \brief Definition of the Checkpoint class
+
+#ifndef Checkpoint_h
+#define Checkpoint_h 1
+
+#include "EventSeeder.hh"
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+class CheckpointMessenger;
+class RunAction;
+
+class G4Run;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Checkpoints of the columnar output of long runs (/dna/checkpoint/), from
+// which an interrupted run is resumed with: dnaphysics macro threads --resume
+// The events of a checkpointed run are seeded from a run seed and their
+// global event ID (see EventSeeder), so that an event gives the same rows in
+// whatever thread or attempt it is processed.
+// At the beginning of the run the master writes dna.checkpoint/run (run ID,
+// events, seed). Every N events, each worker flushes its column files and
+// writes dna.checkpoint/shard<suffix>: the rows of its step, track and
+// cluster tables and the global IDs of its completed events. A complete run
+// removes dna.checkpoint.
+// When resuming, the shards of the interrupted attempts are cut to their
+// checkpointed rows and kept. The run then only processes the events not
+// completed in them (the others are skipped). The shards of a checkpointed
+// run are named after the attempt, e.g. dna.columns/step_r0_t3, then
+// step_r1_t3 once resumed; dna.manifest lists all of them, to be merged
+// with dnamerge.
+
+class Checkpoint
+{
+  public:
+    Checkpoint(RunAction*);
+    ~Checkpoint();
+
+    void SetInterval(G4int value) { fInterval = value; }
+
+    // Master: keeps the interrupted shards aside until their run comes
+    // (the runs before it in the macro are done again, without checkpoints)
+    void Resume();
+
+    void BeginOfRun(const G4Run*);
+    void EndOfRun(const G4Run*);
+
+    G4bool IsActive() const { return fActive; }
+
+    // Suffix of the shards of this attempt (_r<attempt>), "" without checkpoints
+    const G4String& GetShardTag() const { return fShardTag; }
+
+    // Worker: records the event, true when a checkpoint is due
+    G4bool EndOfEvent(G4int globalEventID);
+    void Write(std::uint64_t stepRows, std::uint64_t trackRows, std::uint64_t clusterRows);
+    G4int GetNumberOfEvents() const { return (G4int)fCompletedEvents.size(); }
+
+    // Master: shards of the interrupted attempts, for dna.manifest
+    struct Shard
+    {
+        G4int threadID = 0;
+        G4String suffix;
+        std::vector<G4int> events;  // global event IDs
+        std::uint64_t rows[3] = {0, 0, 0};  // step, track, cluster
+    };
+    const std::vector<Shard>& GetRecoveredShards() const { return fRecoveredShards; }
+    G4int GetNumberOfRecoveredEvents() const;
+
+  private:
+    void BeginOfMasterRun(G4int runID, G4int nofEvents);
+    G4bool ReadRun(G4int runID);
+
+    RunAction* fRunAction = nullptr;
+    G4int fInterval = 0;
+    G4bool fActive = false;
+    G4String fShardTag;
+
+    // Interrupted run waiting for its /run/beamOn
+    G4bool fResumePending = false;
+    G4int fPendingRunID = 0;
+    G4int fPendingEvents = 0;
+    G4int fPendingAttempt = 0;
+    std::uint64_t fPendingSeed = 0;
+    G4int fPendingFirstEvent = 0;
+    G4int fPendingCount = 0;
+    std::vector<Shard> fRecoveredShards;
+
+    // Events completed by this thread in this attempt
+    std::vector<G4int> fCompletedEvents;
+    G4int fEventsSinceCheckpoint = 0;
+
+    // Seeding before the run, restored at its end
+    EventSeeder fSavedSeeder;
+
+    CheckpointMessenger* fMessenger = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
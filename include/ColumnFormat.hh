@@ -0,0 +1,85 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ColumnFormat.hh
+/// \brief Layout of the native columnar output files
+
+#ifndef ColumnFormat_h
+#define ColumnFormat_h 1
+
+// This header has no Geant4 dependency so that analysis tools can include
+// it directly.
+//
+// Each column of a table is stored in its own file <table>/<column>.col:
+// a fixed 64 byte header followed by the raw little-endian values, without
+// padding, so that the data of a file of size S holds (S - 64) / width rows
+// and can be memory-mapped at offset 64 as a plain array.
+
+#include <cstdint>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+enum ColumnType : std::uint32_t
+{
+  kColumnInt32 = 1,
+  kColumnFloat32 = 2,
+  kColumnFloat64 = 3
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+struct ColumnHeader
+{
+  char magic[8];  // "DNACOL01"
+  std::uint32_t version;  // format version, currently 1
+  std::uint32_t type;  // ColumnType
+  std::uint32_t width;  // bytes per value
+  std::uint32_t reserved;
+  std::uint64_t rows;  // number of values, written when the file is closed
+  char name[32];  // column name, null terminated
+};
+
+static_assert(sizeof(ColumnHeader) == 64, "ColumnHeader must be 64 bytes");
+
+constexpr char kColumnMagic[8] = {'D', 'N', 'A', 'C', 'O', 'L', '0', '1'};
+constexpr std::uint32_t kColumnFormatVersion = 1;
+constexpr std::uint64_t kColumnRowsOffset = 24;  // offsetof(ColumnHeader, rows)
+
+inline std::uint32_t ColumnWidth(std::uint32_t type)
+{
+  return type == kColumnInt32 ? 4 : (type == kColumnFloat32 ? 4 : 8);
+}
+
+#endif
@@ -0,0 +1,102 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ColumnWriter.hh
+/// \brief Definition of the ColumnWriter class
+
+#ifndef ColumnWriter_h
+#define ColumnWriter_h 1
+
+#include "ColumnFormat.hh"
+#include "globals.hh"
+
+#include <cstdio>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Writes one table of the native columnar output (see ColumnFormat.hh):
+// a directory holding one fixed-width file per column. Values are appended
+// in blocks; the row counts are written into the headers on Close(), or on
+// Flush() for a checkpoint.
+
+class ColumnWriter
+{
+  public:
+    ColumnWriter() = default;
+    ~ColumnWriter();
+
+    ColumnWriter(const ColumnWriter&) = delete;
+    ColumnWriter& operator=(const ColumnWriter&) = delete;
+
+    // Creates the directory; columns are then added in order
+    void Open(const G4String& directory);
+    G4int AddColumn(const G4String& name, ColumnType type);
+    void Close();
+
+    // Writes the buffered values and the row counts; the files are then
+    // complete up to this point
+    void Flush();
+
+    // Appends n values to a column; doubles are narrowed for float32 columns
+    void Write(G4int column, const G4int* values, std::size_t n);
+    void Write(G4int column, const G4double* values, std::size_t n);
+
+    G4bool IsOpen() const { return fOpen; }
+    std::size_t GetBytesWritten() const { return fBytesWritten; }
+
+    // Rows of the table (all the columns are filled together)
+    std::uint64_t GetRows() const { return fColumns.empty() ? 0 : fColumns.front().rows; }
+
+  private:
+    struct Column
+    {
+        std::FILE* file = nullptr;
+        ColumnType type = kColumnFloat64;
+        std::uint64_t rows = 0;
+    };
+
+    void WriteRaw(Column&, const void* data, std::size_t n);
+
+    G4String fDirectory;
+    std::vector<Column> fColumns;
+    std::vector<float> fScratch;
+    std::size_t fBytesWritten = 0;
+    G4bool fOpen = false;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,117 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file DamageClusterer.hh
+/// \brief Definition of the DamageClusterer class
+
+#ifndef DamageClusterer_h
+#define DamageClusterer_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class ColumnWriter;
+class DamageClustererMessenger;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// DBSCAN clustering of the energy transfer points of each event.
+// Points are buffered during the event; at the end of the event they are
+// indexed in a cell list of cell size eps, so that a neighbourhood query
+// only visits the 27 surrounding cells, and clustered with the usual DBSCAN
+// rules (core points have at least minPts points, themselves included,
+// within eps). One row per cluster is written to the "cluster" ntuple, or
+// to the cluster table of the columnar output.
+
+class DamageClusterer
+{
+  public:
+    DamageClusterer();
+    ~DamageClusterer();
+
+    void AddPoint(const G4ThreeVector& position, G4double edep)
+    {
+      if (edep < fMinEnergy) return;
+      fPositions.push_back(position);
+      fEnergies.push_back(edep);
+    }
+
+    void BeginOfEvent();
+    void EndOfEvent(G4int eventID);
+
+    void SetActive(G4bool value) { fActive = value; }
+    void SetEpsilon(G4double value) { fEpsilon = value; }
+    void SetMinPoints(G4int value) { fMinPoints = value; }
+    void SetMinEnergy(G4double value) { fMinEnergy = value; }
+    void SetColumnWriter(ColumnWriter* writer) { fColumnWriter = writer; }
+
+    G4bool IsActive() const { return fActive; }
+
+    // Results of the last event
+    G4int GetNumberOfClusters() const { return fNumberOfClusters; }
+    G4int GetNumberOfNoisePoints() const { return fNumberOfNoisePoints; }
+
+  private:
+    using CellKey = std::uint64_t;
+
+    CellKey Key(const G4ThreeVector&, G4int di = 0, G4int dj = 0, G4int dk = 0) const;
+    void RegionQuery(std::size_t point, std::vector<std::size_t>& neighbours) const;
+    void WriteCluster(G4int eventID, G4int clusterID, const std::vector<std::size_t>& members);
+
+    G4bool fActive = false;
+    G4double fEpsilon;
+    G4int fMinPoints = 2;
+    G4double fMinEnergy = 0.;
+
+    // Points of the current event
+    std::vector<G4ThreeVector> fPositions;
+    std::vector<G4double> fEnergies;
+
+    std::unordered_map<CellKey, std::vector<std::size_t>> fCells;
+
+    ColumnWriter* fColumnWriter = nullptr;
+    G4int fNumberOfClusters = 0;
+    G4int fNumberOfNoisePoints = 0;
+
+    DamageClustererMessenger* fMessenger = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -65,7 +65,8 @@ class DetectorConstruction : public G4VUserDetectorConstruction
     
     G4Material* 
     MaterialWithDensity(G4String, G4double); 
-    G4double GetSize() {return fWorldSize;};
+    G4double GetSize() const {return fWorldSize;};
+    const G4Material* GetMaterial() const {return fpWaterMaterial;};
      
   private:
    
@@ -66,6 +66,8 @@ class DetectorMessenger : public G4UImessenger
     G4UIcmdWithAString* fpMaterCmd;
     G4UIcmdWithAString* fpPhysCmd;
     G4UIcmdWithABool* fpTrackingCutCmd;
+    G4UIcmdWithAString* fpTableCacheCmd;
+    G4UIcmdWithAString* fpPhysicsScopeCmd;
     G4UIcommand* fDensityCmd;
     G4UIcmdWithADoubleAndUnit* fSizeCmd;
 };
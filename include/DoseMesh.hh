@@ -0,0 +1,116 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file DoseMesh.hh
+/// \brief Definition of the DoseMesh class
+
+#ifndef DoseMesh_h
+#define DoseMesh_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Cubic voxel mesh of deposited energy covering the world volume.
+// Each Run holds its own mesh, filled without locking by the stepping action
+// of its thread, and the meshes are added in Run::Merge. The storage is
+// either dense (one value per voxel) or sparse (hash map of the voxels with
+// a deposit), for the mostly empty volumes around single tracks.
+//
+// Write() stores the dose in a binary file, with a 64 byte header:
+//   char magic[8] "DNADOSE1", uint32 sparse, uint32 nx, ny, nz,
+//   float64 voxel size (nm), float64 density (g/cm3), uint64 number of
+//   values, 16 reserved bytes;
+// followed, for a dense mesh, by nx*ny*nz float64 doses (Gy, x fastest), or,
+// for a sparse mesh, by (uint64 index, float64 dose) pairs sorted by index,
+// with index = ix + nx * (iy + ny * iz). The mesh is centred on the origin,
+// like the world volume.
+
+class DoseMesh
+{
+  public:
+    DoseMesh() = default;
+    ~DoseMesh() = default;
+
+    void Configure(G4double worldSize, G4double voxelSize, G4bool sparse);
+    G4bool IsConfigured() const { return fN > 0; }
+
+    void Fill(const G4ThreeVector& position, G4double edep)
+    {
+      // The mesh is at least as large as the world, so that the offsets
+      // are positive and truncation is floor
+      G4long ix = (G4long)((position.x() + fHalfSize) * fInverseVoxelSize);
+      G4long iy = (G4long)((position.y() + fHalfSize) * fInverseVoxelSize);
+      G4long iz = (G4long)((position.z() + fHalfSize) * fInverseVoxelSize);
+      if (ix < 0 || iy < 0 || iz < 0 || ix >= fN || iy >= fN || iz >= fN) return;
+
+      std::uint64_t index = ix + fN * (iy + fN * iz);
+      if (fSparse) {
+        fSparseEnergy[index] += edep;
+      }
+      else {
+        fDenseEnergy[index] += edep;
+      }
+    }
+
+    void Merge(const DoseMesh&);
+    void Write(const G4String& fileName, G4double density) const;
+
+    // Restores the energies of a file written by Write(), e.g. to add the
+    // meshes of the processes of a sharded run; false if it cannot be read
+    G4bool Read(const G4String& fileName, G4double& density);
+
+    G4long GetNumberOfVoxels() const { return fN * fN * fN; }
+    std::size_t GetNumberOfFilledVoxels() const;
+
+  private:
+    G4long fN = 0;  // voxels per axis
+    G4double fVoxelSize = 0.;
+    G4double fHalfSize = 0.;
+    G4double fInverseVoxelSize = 0.;
+    G4bool fSparse = true;
+
+    std::vector<G4double> fDenseEnergy;
+    std::unordered_map<std::uint64_t, G4double> fSparseEnergy;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
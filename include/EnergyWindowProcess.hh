@@ -0,0 +1,116 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file EnergyWindowProcess.hh
+/// \brief Definition of the EnergyWindowProcess class
+
+#ifndef EnergyWindowProcess_h
+#define EnergyWindowProcess_h 1
+
+#include "G4ThreeVector.hh"
+#include "G4WrapperProcess.hh"
+#include "globals.hh"
+
+#include <cfloat>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Kinetic energy window of a discrete process: [minEnergy, maxEnergy)
+struct EnergyWindow
+{
+    G4double minEnergy = 0.;
+    G4double maxEnergy = DBL_MAX;
+
+    G4bool IsFull() const { return minEnergy <= 0. && maxEnergy == DBL_MAX; }
+};
+
+// Discrete process restricted to an energy window: outside of it the
+// wrapped process is not asked for its interaction length, so that its cross
+// section is not computed (it behaves as a zero cross section). The wrapper
+// has the name, type and sub-type of the wrapped process.
+//
+// Inside the window the cross section can be enhanced by a factor f >= 1
+// (interaction forcing): the wrapped process sees the step lengths
+// multiplied by f, so that its mean free path is divided by f. At each
+// interaction the secondaries and the energy deposit get the weight w/f
+// (see GetInteractionWeight), and the change of the primary is only kept
+// with the probability 1/f, so that the primary keeps its weight w. The
+// change undone by this roulette is kept for the step tallies, which are
+// weighted by w/f (see IsChangeRestored).
+// The wrapped process must be a G4VEmProcess (G4ParticleChangeForGamma).
+//
+// The window and the factor are read at each step, so that they can be
+// changed between runs.
+
+class EnergyWindowProcess : public G4WrapperProcess
+{
+  public:
+    EnergyWindowProcess(G4VProcess*, const EnergyWindow*, const G4double* bias);
+    ~EnergyWindowProcess() override = default;
+
+    G4double PostStepGetPhysicalInteractionLength(const G4Track&, G4double previousStepSize,
+                                                  G4ForceCondition*) override;
+    G4VParticleChange* PostStepDoIt(const G4Track&, const G4Step&) override;
+
+    // Weight of the last interaction of this process (track weight / f)
+    G4double GetInteractionWeight() const { return fInteractionWeight; }
+
+    // Whether the roulette restored the primary at the last interaction,
+    // and its kinetic energy and direction proposed by the wrapped process
+    G4bool IsChangeRestored() const { return fChangeRestored; }
+    G4double GetInteractionKineticEnergy() const { return fInteractionKineticEnergy; }
+    const G4ThreeVector& GetInteractionDirection() const { return fInteractionDirection; }
+
+    // Factor of the cross section of the wrapped process at this energy:
+    // 0 outside of the window, f inside
+    G4double GetCrossSectionFactor(G4double kineticEnergy) const
+    {
+      if (kineticEnergy < fWindow->minEnergy || kineticEnergy >= fWindow->maxEnergy) return 0.;
+      return *fBias;
+    }
+    G4VProcess* GetWrappedProcess() const { return pRegProcess; }
+
+  private:
+    const EnergyWindow* fWindow = nullptr;
+    const G4double* fBias = nullptr;
+    G4double fInteractionWeight = 1.;
+    G4bool fChangeRestored = false;
+    G4double fInteractionKineticEnergy = 0.;
+    G4ThreeVector fInteractionDirection;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
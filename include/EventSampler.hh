@@ -0,0 +1,159 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file EventSampler.hh
+/// \brief Definition of the EventSampler class
+
+#ifndef EventSampler_h
+#define EventSampler_h 1
+
+#include "StepBuffer.hh"
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Row of the track ntuple, in output units (nm, eV)
+struct TrackRecord
+{
+    G4int flagParticle;
+    G4double x, y, z;
+    G4double dirx, diry, dirz;
+    G4double kineticEnergy;
+    G4int trackID, parentID;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Per-thread sampling of the recorded events and steps, set with
+// /dna/output/sampling, to cap the size of the step and track output:
+//  - all: every event and step is recorded (default)
+//  - every N: only the events with eventID % N == 0
+//  - reservoir K: K events per thread, uniformly chosen among all the events
+//    of the thread (reservoir sampling); the steps and tracks of the kept
+//    events are held in memory and written at the end of the run
+//  - steps f: a fraction f of the steps of every event (all tracks)
+// The random numbers come from a stream seeded with the sampling seed and the
+// event ID, so that the selection does not depend on the Geant4 random engine
+// nor on the thread scheduling of the steps.
+
+class EventSampler
+{
+  public:
+    enum Mode
+    {
+      kSampleAll = 0,
+      kSampleEvery = 1,
+      kSampleReservoir = 2,
+      kSampleSteps = 3
+    };
+
+    EventSampler() = default;
+    ~EventSampler() = default;
+
+    void SetMode(const G4String& mode, G4double value);
+    void SetSeed(G4long seed) { fSeed = (std::uint64_t)seed; }
+    Mode GetMode() const { return fMode; }
+    G4String GetModeName() const;
+    G4double GetValue() const { return fValue; }
+
+    void BeginOfRun();
+    void BeginOfEvent(G4int eventID);
+    void EndOfEvent(StepBuffer&);
+
+    // Recording decisions of the current event
+    G4bool IsEventRecorded() const { return fRecordEvent; }
+    G4bool KeepStep()
+    {
+      if (!fRecordEvent) return false;
+      return fMode != kSampleSteps || Uniform() < fValue;
+    }
+
+    // In reservoir mode the steps stay in the StepBuffer until the end of
+    // the event and the tracks are held here
+    G4bool IsHoldingEvents() const { return fMode == kSampleReservoir; }
+    void AddTrack(const TrackRecord& track) { fTracks.push_back(track); }
+
+    // Events kept in the reservoir, sorted by event ID: their steps are
+    // swapped into the buffer, which is then flushed by the caller
+    std::size_t GetNumberOfHeldEvents() const { return fSlots.size(); }
+    void SwapHeldSteps(std::size_t i, StepBuffer& buffer) { buffer.SwapRows(fSlots[i].steps); }
+    const std::vector<TrackRecord>& GetHeldTracks(std::size_t i) const { return fSlots[i].tracks; }
+    void ClearHeldEvents() { fSlots.clear(); }
+    void SortHeldEvents();
+
+    // Statistics of the run
+    G4int GetNumberOfEvents() const { return fEventsSeen; }
+    G4int GetNumberOfRecordedEvents() const { return fEventsRecorded; }
+    G4double GetSamplingFactor() const;
+
+  private:
+    struct Slot
+    {
+        G4int eventID = 0;
+        StepBuffer steps{0};
+        std::vector<TrackRecord> tracks;
+    };
+
+    G4double Uniform()
+    {
+      // splitmix64
+      std::uint64_t z = (fState += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      z ^= z >> 31;
+      return (z >> 11) * 0x1.0p-53;
+    }
+
+    Mode fMode = kSampleAll;
+    G4double fValue = 1.;
+    std::uint64_t fSeed = 0;
+    std::uint64_t fState = 0;
+
+    G4int fEventID = 0;
+    G4bool fRecordEvent = true;
+    G4int fEventsSeen = 0;
+    G4int fEventsRecorded = 0;
+
+    std::vector<Slot> fSlots;
+    std::vector<TrackRecord> fTracks;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,102 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file EventSeeder.hh
+/// \brief Definition of the EventSeeder class
+
+#ifndef EventSeeder_h
+#define EventSeeder_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Seeding of each event from a run seed and its global event ID, instead of
+// the seeds drawn by the master, so that an event gives the same result in
+// whatever run, thread or process it is processed. Used to extend cached
+// runs (see RunCache), to resume interrupted runs (see Checkpoint) and to
+// split runs between processes (see ShardSelection).
+// Event i of the run has the global event ID firstEvent + i or, in a resumed
+// run, the i-th ID of the events left to do. The events beyond the number of
+// events of this process, or beyond this list, are skipped (no primary).
+
+class EventSeeder
+{
+  public:
+    EventSeeder() = default;
+    ~EventSeeder() = default;
+
+    // Seed 0: the events keep the seeds of the master (Geant4 default)
+    void SetSeed(std::uint64_t value) { fSeed = value; }
+    void SetFirstEvent(G4int value) { fFirstEvent = value; }
+    void SetNumberOfEvents(G4int value) { fNumberOfEvents = value; }
+    void SetEventIDs(const std::vector<G4int>& value)
+    {
+      fEventIDs = value;
+      fResumed = true;
+    }
+    void Reset();
+
+    G4bool IsActive() const { return fSeed != 0; }
+    std::uint64_t GetSeed() const { return fSeed; }
+    G4int GetFirstEvent() const { return fFirstEvent; }
+    G4int GetNumberOfEvents() const { return fNumberOfEvents; }
+
+    // -1 for the skipped events of a resumed run
+    G4int GetGlobalEventID(G4int eventID) const
+    {
+      if (!fResumed) {
+        return (fNumberOfEvents < 0 || eventID < fNumberOfEvents) ? fFirstEvent + eventID : -1;
+      }
+      return eventID < (G4int)fEventIDs.size() ? fEventIDs[eventID] : -1;
+    }
+
+    // Seeds the random engine of this thread
+    void SeedEvent(G4int globalEventID) const;
+
+  private:
+    std::uint64_t fSeed = 0;
+    G4int fFirstEvent = 0;
+    G4int fNumberOfEvents = -1;  // all the events of the run
+    std::vector<G4int> fEventIDs;
+    G4bool fResumed = false;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
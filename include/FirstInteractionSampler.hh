@@ -0,0 +1,112 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file FirstInteractionSampler.hh
+/// \brief Definition of the FirstInteractionSampler class
+
+#ifndef FirstInteractionSampler_h
+#define FirstInteractionSampler_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+class FirstInteractionMessenger;
+class RunAction;
+
+class G4MaterialCutsCouple;
+class G4ParticleDefinition;
+class G4ParticleGun;
+class G4VProcess;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Direct sampling of the first interaction of the primary particle, for
+// single-collision studies (e.g. elastic.in, test_hydrogen.in).
+// When active, the events have no primary vertex: instead, each event samples
+// the first interaction of N primaries defined by the particle gun, in the
+// material of the world volume taken as infinite. For each primary, the
+// active discrete processes of the particle (not the inactivated ones) give a
+// distance to interaction, as in G4SteppingManager, and the closest one is
+// applied with its PostStepDoIt. The step (without its secondaries) is then
+// recorded like the first step of a tracked primary.
+// The events are distributed over the threads as usual, so that the samples
+// use the physics tables and random engines of the worker threads.
+//
+// With the forced collision, the first interaction is forced inside the world
+// volume instead: its distance is sampled from the exponential distribution
+// of the total cross section truncated at the world boundary (distance L
+// along the gun direction), and the step gets the weight 1 - exp(-Sigma L),
+// the probability of an interaction inside the world. The process is chosen
+// in proportion to its cross section, including the /dna/mi/bias factors
+// (compensated in the weight). With these factors, the first interactions
+// in the infinite medium are sampled the same way (weight sigma'/sigma),
+// since the closest interaction would follow the enhanced cross sections.
+
+class FirstInteractionSampler
+{
+  public:
+    FirstInteractionSampler();
+    ~FirstInteractionSampler();
+
+    void SetActive(G4bool value) { fActive = value; }
+    void SetSamplesPerEvent(G4int value) { fSamplesPerEvent = value; }
+    void SetForceInWorld(G4bool value) { fForceInWorld = value; }
+    G4bool IsActive() const { return fActive; }
+    G4int GetSamplesPerEvent() const { return fSamplesPerEvent; }
+
+    // Samples the first interactions of one event; returns their number
+    G4int Sample(const G4ParticleGun&, G4int eventID, RunAction&);
+
+  private:
+    void SetParticle(const G4ParticleDefinition*);
+    G4VProcess* ForceInteraction(G4double energy, const G4MaterialCutsCouple*,
+                                 G4double worldDistance, G4double& length, G4double& weight);
+
+    G4bool fActive = false;
+    G4int fSamplesPerEvent = 1000;
+    G4bool fForceInWorld = false;
+
+    // Active discrete processes of the current particle
+    const G4ParticleDefinition* fParticle = nullptr;
+    std::vector<G4VProcess*> fProcesses;
+    std::vector<G4double> fCrossSections;  // scratch, forced collision
+
+    FirstInteractionMessenger* fMessenger = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
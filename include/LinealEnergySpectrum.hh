@@ -0,0 +1,83 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file LinealEnergySpectrum.hh
+/// \brief Definition of the LinealEnergySpectrum class
+
+#ifndef LinealEnergySpectrum_h
+#define LinealEnergySpectrum_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Weighted, logarithmically binned frequency distribution of the lineal
+// energy y (in keV/um), with the sums needed for the frequency-mean yF and
+// the dose-mean yD. One instance is held by each Run and merged into the
+// master run.
+
+class LinealEnergySpectrum
+{
+  public:
+    LinealEnergySpectrum() = default;
+    ~LinealEnergySpectrum() = default;
+
+    void SetBinning(G4double yMin, G4double yMax, G4int binsPerDecade);
+    void Fill(G4double y, G4double weight);
+    void Merge(const LinealEnergySpectrum&);
+
+    G4double GetSumOfWeights() const { return fSumW; }
+    G4double GetFrequencyMean() const;  // yF
+    G4double GetDoseMean() const;  // yD
+
+    // Writes f(y) and d(y), normalised to unit area, as a text table
+    void Write(const G4String& fileName, const G4String& description) const;
+
+  private:
+    G4double fLogYMin = 0.;
+    G4double fBinsPerDecade = 1.;
+    std::vector<G4double> fWeights;
+
+    G4double fSumW = 0.;
+    G4double fSumWY = 0.;
+    G4double fSumWY2 = 0.;
+    G4double fOutOfRange = 0.;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,127 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file MicrodosimetryScorer.hh
+/// \brief Definition of the MicrodosimetryScorer class
+
+#ifndef MicrodosimetryScorer_h
+#define MicrodosimetryScorer_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class LinealEnergySpectrum;
+class MicrodosimetryMessenger;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Online lineal energy scorer. The energy deposits of an event are buffered
+// and, at the end of the event, summed in spherical or cylindrical (axis
+// along z) sites:
+//  - tiled: sites inscribed in a randomly shifted lattice of cells; every
+//    site with an energy deposit is one entry of weight 1;
+//  - random: each site is placed uniformly around a randomly chosen
+//    deposit, and is weighted by 1/n where n is the number of deposits it
+//    contains (times deposits per event / sites per event), which removes
+//    the bias of placing sites on the deposits.
+// The deposits are indexed with a spatial hash of cells as large as a site,
+// so that a site only needs the deposits of the neighbouring cells.
+// y = energy imparted / mean chord length of the site.
+
+class MicrodosimetryScorer
+{
+  public:
+    MicrodosimetryScorer();
+    ~MicrodosimetryScorer();
+
+    void AddDeposit(const G4ThreeVector& position, G4double edep)
+    {
+      fPositions.push_back(position);
+      fEnergies.push_back(edep);
+    }
+
+    void BeginOfEvent();
+    void EndOfEvent(LinealEnergySpectrum&);
+
+    void SetActive(G4bool value) { fActive = value; }
+    void SetCylinder(G4bool value) { fCylinder = value; }
+    void SetDiameter(G4double value) { fDiameter = value; }
+    void SetHeight(G4double value) { fHeight = value; }
+    void SetRandomPlacement(G4bool value) { fRandomPlacement = value; }
+    void SetNumberOfSites(G4int value) { fNumberOfSites = value; }
+    void SetBinsPerDecade(G4int value) { fBinsPerDecade = value; }
+
+    G4bool IsActive() const { return fActive; }
+    G4double GetMeanChordLength() const;
+    G4int GetBinsPerDecade() const { return fBinsPerDecade; }
+    G4String GetDescription() const;
+
+  private:
+    using CellKey = std::uint64_t;
+
+    CellKey Key(G4double x, G4double y, G4double z) const;
+    G4bool Contains(const G4ThreeVector& center, const G4ThreeVector& point) const;
+    G4ThreeVector SampleInSite() const;
+    void BuildIndex();
+    void ScoreTiled(LinealEnergySpectrum&);
+    void ScoreRandom(LinealEnergySpectrum&);
+
+    G4bool fActive = false;
+    G4bool fCylinder = false;
+    G4double fDiameter;
+    G4double fHeight;  // cylinder only
+    G4bool fRandomPlacement = false;
+    G4int fNumberOfSites = 100;  // per event, random placement only
+    G4int fBinsPerDecade = 50;
+
+    // Deposits of the current event
+    std::vector<G4ThreeVector> fPositions;
+    std::vector<G4double> fEnergies;
+
+    // Spatial hash of the deposits
+    G4ThreeVector fCellSize;
+    G4ThreeVector fOrigin;
+    std::unordered_map<CellKey, std::vector<std::size_t>> fCells;
+
+    MicrodosimetryMessenger* fMessenger = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,78 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file MultipleIonisationMessenger.hh
+/// \brief Definition of the MultipleIonisationMessenger class
+
+#ifndef MultipleIonisationMessenger_h
+#define MultipleIonisationMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class PhysicsList;
+
+class G4UIdirectory;
+class G4UIcommand;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class MultipleIonisationMessenger : public G4UImessenger
+{
+  public:
+    MultipleIonisationMessenger(PhysicsList*);
+    ~MultipleIonisationMessenger() override;
+
+    void SetNewValue(G4UIcommand*, G4String) override;
+
+  private:
+    // Particle indices and multiplicities of "proton 3", "all all"...;
+    // false if a name is unknown
+    G4bool Select(const G4String& particle, const G4String& multiplicity,
+                  std::vector<G4int>& particles, std::vector<G4int>& multiplicities) const;
+
+    PhysicsList* fPhysicsList = nullptr;
+
+    G4UIdirectory* fMIDir = nullptr;
+    G4UIcommand* fEnableCmd = nullptr;
+    G4UIcommand* fWindowCmd = nullptr;
+    G4UIcommand* fBiasCmd = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
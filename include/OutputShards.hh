@@ -0,0 +1,90 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file OutputShards.hh
+/// \brief Definition of the OutputShards class
+
+#ifndef OutputShards_h
+#define OutputShards_h 1
+
+#include "globals.hh"
+
+#include <string>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Outputs of several runs (segments of a cached run, or the processes of a
+// sharded run) combined into one dataset in the current directory. The
+// shards of each part are renamed after its tag, e.g. dna_c1.root,
+// dna_c1_t3.root or dna.columns/step_s2_t3, and listed in dna.manifest, to
+// be merged with dnamerge. The master file of a part with ROOT shards
+// (histograms and meta ntuple) is renamed after its tag too, e.g.
+// dna_s2.root, and listed as a "master" input.
+
+class OutputShards
+{
+  public:
+    OutputShards() = default;
+    ~OutputShards() = default;
+
+    // Directory holding the output of a run: dna.root, or the shards listed
+    // in its dna.manifest
+    void Add(const std::string& directory, const std::string& tag, G4int nofEvents);
+
+    // Copies (or moves) the shards of all parts and writes dna.manifest;
+    // throws std::filesystem::filesystem_error
+    void Combine(G4bool move, const std::string& title) const;
+
+    G4int GetNumberOfParts() const { return (G4int)fParts.size(); }
+
+    // Output of a run in the working directory (see RunAction), including
+    // the shards of combined outputs (dna_cN..., dna_sN...)
+    static G4bool IsOutput(const std::string& name);
+    static void RemoveOutputs();
+
+  private:
+    struct Part
+    {
+        std::string directory;
+        std::string tag;
+        G4int events = 0;
+    };
+    std::vector<Part> fParts;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,88 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ParameterScan.hh
+/// \brief Definition of the ParameterScan class
+
+#ifndef ParameterScan_h
+#define ParameterScan_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+class ParameterScanMessenger;
+class RunAction;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Scan of the gun particle, gun energy and water density in one session
+// (/dna/test/scan/): /dna/test/scan/beamOn N runs N events for each point
+// of the grid (densities x particles x energies), changing only the
+// settings that differ from the previous point. The physics is constructed
+// once; a new density only rebuilds the tables of the new material.
+// The output of point i is moved to dna.scan/point<i>/, and
+// dna.scan/points lists the points with their settings and run time.
+// The gun and the material are left at the last point.
+
+class ParameterScan
+{
+  public:
+    ParameterScan(RunAction*);
+    ~ParameterScan();
+
+    // An empty list keeps the current setting
+    void SetEnergies(const std::vector<G4double>& values) { fEnergies = values; }
+    void SetParticles(const std::vector<G4String>& values) { fParticles = values; }
+    void SetDensities(const std::vector<G4double>& values) { fDensities = values; }
+    void SetCached(G4bool value) { fCached = value; }
+    void Clear();
+
+    // Runs nofEvents events per point (master thread)
+    void BeamOn(G4int nofEvents);
+
+  private:
+    RunAction* fRunAction = nullptr;
+    std::vector<G4double> fEnergies;
+    std::vector<G4String> fParticles;
+    std::vector<G4double> fDensities;
+    G4bool fCached = false;  // points run with /dna/cache/beamOn
+
+    ParameterScanMessenger* fMessenger = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
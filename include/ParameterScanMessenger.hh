@@ -0,0 +1,82 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ParameterScanMessenger.hh
+/// \brief Definition of the ParameterScanMessenger class
+
+#ifndef ParameterScanMessenger_h
+#define ParameterScanMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class ParameterScan;
+
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithoutParameter;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class ParameterScanMessenger : public G4UImessenger
+{
+  public:
+    ParameterScanMessenger(ParameterScan*);
+    ~ParameterScanMessenger() override;
+
+    void SetNewValue(G4UIcommand*, G4String) override;
+
+  private:
+    // Values of a list with an optional unit at the end, e.g. "1 10 100 keV"
+    std::vector<G4double> ParseValues(const G4String&, const char* category) const;
+
+    ParameterScan* fScan = nullptr;
+
+    G4UIdirectory* fScanDir = nullptr;
+    G4UIcmdWithAString* fEnergiesCmd = nullptr;
+    G4UIcmdWithAString* fParticlesCmd = nullptr;
+    G4UIcmdWithAString* fDensitiesCmd = nullptr;
+    G4UIcmdWithABool* fCachedCmd = nullptr;
+    G4UIcmdWithoutParameter* fClearCmd = nullptr;
+    G4UIcmdWithAnInteger* fBeamOnCmd = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -39,9 +39,17 @@
 #ifndef PhysicsList_h
 #define PhysicsList_h 1
 
+#include "EnergyWindowProcess.hh"
+#include "PhysicsTableCache.hh"
+
 #include "G4VModularPhysicsList.hh"
 #include "globals.hh"
 
+#include <set>
+#include <vector>
+
+class MultipleIonisationMessenger;
+
 class G4VPhysicsConstructor;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -54,21 +62,60 @@ class PhysicsList : public G4VModularPhysicsList
 
     void ConstructParticle() override;
     void ConstructProcess() override;
+    void SetCuts() override;
 
     void AddPhysics(const G4String&);
     void SetTrackingCut(G4bool);
 
+    // Processes only for the particles reachable from these primaries
+    // ("all": every particle, default); maxEnergy <= 0: unknown
+    void SetPhysicsScope(const std::vector<G4String>& primaries, G4double maxEnergy);
+
+    // Double, triple and quadruple ionisation processes (/dna/mi/) of the
+    // particles proton, alpha, GenericIon and hydrogen (index 0-3),
+    // multiplicity 2-4; hydrogen is off by default
+    static const G4int kNMIParticles = 4;
+    static G4int GetMIParticleIndex(const G4String& name);
+    void SetMultipleIonisation(G4int particle, G4int multiplicity, G4bool enabled);
+    void SetMultipleIonisationWindow(G4int particle, G4int multiplicity, G4double minEnergy,
+                                     G4double maxEnergy);
+    // Cross section enhancement factor (see EnergyWindowProcess)
+    void SetMultipleIonisationBias(G4int particle, G4int multiplicity, G4double factor);
+    G4bool IsMultipleIonisationBiased() const;
+
+    // Warm start from stored physics tables (see PhysicsTableCache)
+    void SetTableCacheDirectory(const G4String& value) { fTableCache.SetDirectory(value); }
+    void StoreTableCache() { fTableCache.Store(this); }
+
   private:
     void TrackingCut();
 
     void ConstructMultipleIonisationProcess();
 
+    // Particles reachable from the primaries of the scope, with their
+    // secondaries; empty: all
+    std::set<G4String> GetScopeParticles() const;
+    void ApplyPhysicsScope();
+
+    // Constructors and options, for the key of the table cache
+    G4String GetConstructorNames() const;
+
     G4VPhysicsConstructor* fEmPhysicsList = nullptr;
     G4VPhysicsConstructor* fDecayPhysicsList = nullptr;
     G4VPhysicsConstructor* fRadDecayPhysicsList = nullptr;
 
     G4String fEmPhysics = "";
     G4bool fIsTrackingCutSet = true;
+
+    G4bool fMIEnabled[kNMIParticles][3];
+    EnergyWindow fMIWindows[kNMIParticles][3];
+    G4double fMIBias[kNMIParticles][3];
+    MultipleIonisationMessenger* fMIMessenger = nullptr;
+
+    std::vector<G4String> fScopePrimaries;
+    G4double fScopeMaxEnergy = 0.;
+
+    PhysicsTableCache fTableCache;
 };
 
 #endif
@@ -0,0 +1,92 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file PhysicsTableCache.hh
+/// \brief Definition of the PhysicsTableCache class
+
+#ifndef PhysicsTableCache_h
+#define PhysicsTableCache_h 1
+
+#include "globals.hh"
+
+#include <string>
+
+class G4VUserPhysicsList;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Warm start of the physics (/dna/test/physicsTableCache directory): the
+// physics tables built by the first run of a configuration are stored in
+// <directory>/<key>, and retrieved instead of built at the next starts.
+// The key is a hash of the Geant4 version and tag, the data set directories
+// (G4LEDATA...), the constructors with the enabled multiple ionisations and
+// the physics scope (see PhysicsList::GetConstructorNames), the cuts, the
+// EM parameters (energy range, bins, options) and the materials, so that a
+// change of any of them builds and stores new tables.
+// The tables are those of the processes that build them (standard EM,
+// DNA processes with tables); the models reading their data at
+// initialisation (DNA cross sections, radioactive decay) still read them.
+// Master thread only: the workers share its tables.
+
+class PhysicsTableCache
+{
+  public:
+    PhysicsTableCache() = default;
+    ~PhysicsTableCache() = default;
+
+    // "" or "none": no cache
+    void SetDirectory(const G4String& value) { fDirectory = (value == "none") ? "" : value; }
+    G4bool IsActive() const { return !fDirectory.empty(); }
+
+    // Configuration hashed into the key, one setting per line
+    std::string GetConfiguration(const G4String& constructors,
+                                 const G4VUserPhysicsList*) const;
+    std::string GetKey(const G4String& constructors, const G4VUserPhysicsList*) const;
+
+    // At the initialisation: retrieves the stored tables, if any
+    void Retrieve(const G4String& constructors, G4VUserPhysicsList*);
+
+    // After a run: stores the tables built for a new key
+    void Store(G4VUserPhysicsList*);
+
+  private:
+    G4String fDirectory;
+    std::string fPendingDirectory;  // tables to store after the run
+    std::string fPendingConfiguration;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -44,15 +44,20 @@
 #include "G4ParticleGun.hh"
 #include "G4VUserPrimaryGeneratorAction.hh"
 
+class RunAction;
+
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
   public:
-    PrimaryGeneratorAction();
+    PrimaryGeneratorAction(RunAction*);
     virtual ~PrimaryGeneratorAction();
 
     virtual void GeneratePrimaries(G4Event*);
 
+    const G4ParticleGun* GetParticleGun() const { return fpParticleGun; }
+
   private:
     G4ParticleGun* fpParticleGun;
+    RunAction* fRunAction = nullptr;
 };
 #endif
@@ -0,0 +1,125 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ProcessProfile.hh
+/// \brief Definition of the ProcessProfile class
+
+#ifndef ProcessProfile_h
+#define ProcessProfile_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Number of steps, deposited energy and time per (particle, process) pair,
+// indexed by the flags of StepClassifier. Steps limited by the transportation
+// and unclassified particles or processes have their own entries.
+// Each Run holds its own profile, filled by the stepping action of its thread
+// (see SteppingAction::Profile) and added in Run::Merge.
+// The time is sampled: one step out of N is timed, from the previous call of
+// the stepping action in the same event, and counted N times. It is the CPU
+// time of the thread (elapsed time on Windows).
+
+class ProcessProfile
+{
+  public:
+    // Extra process entries
+    static constexpr G4int kNProcessFlags = 1024;
+    static constexpr G4int kTransportation = kNProcessFlags;
+    static constexpr G4int kOtherProcess = kNProcessFlags + 1;
+
+    ProcessProfile() = default;
+    ~ProcessProfile() = default;
+
+    void Configure();
+    G4bool IsConfigured() const { return !fEntries.empty(); }
+
+    void AddStep(G4int flagParticle, G4int process, G4double edep)
+    {
+      Entry& entry = fEntries[Index(flagParticle, process)];
+      ++entry.steps;
+      entry.energy += edep;
+    }
+    void AddTime(G4int flagParticle, G4int process, G4double seconds)
+    {
+      fEntries[Index(flagParticle, process)].time += seconds;
+    }
+    G4bool HasName(G4int flagParticle, G4int process) const
+    {
+      return !fNames[Index(flagParticle, process)].empty();
+    }
+    void SetName(G4int flagParticle, G4int process, const G4String& name)
+    {
+      fNames[Index(flagParticle, process)] = name;
+    }
+
+    void Merge(const ProcessProfile&);
+
+    void Print() const;
+    void WriteJson(const G4String& fileName) const;
+
+  private:
+    // Particle flags 0-7 of StepClassifier, then other particles
+    static constexpr G4int kNParticles = 9;
+    static constexpr G4int kNProcesses = kNProcessFlags + 2;
+
+    struct Entry
+    {
+        G4long steps = 0;
+        G4double energy = 0.;
+        G4double time = 0.;  // seconds
+    };
+
+    static std::size_t Index(G4int flagParticle, G4int process)
+    {
+      if (flagParticle < 0 || flagParticle >= kNParticles - 1) flagParticle = kNParticles - 1;
+      if (process < 0 || process >= kNProcesses) process = kOtherProcess;
+      return (std::size_t)flagParticle * kNProcesses + process;
+    }
+
+    // Entries with at least one step, sorted by decreasing time
+    std::vector<std::size_t> SortedEntries() const;
+    G4String ParticleName(std::size_t index) const;
+    G4String ProcessName(std::size_t index) const;
+
+    std::vector<Entry> fEntries;
+    std::vector<G4String> fNames;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
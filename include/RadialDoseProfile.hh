@@ -0,0 +1,85 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file RadialDoseProfile.hh
+/// \brief Definition of the RadialDoseProfile class
+
+#ifndef RadialDoseProfile_h
+#define RadialDoseProfile_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Energy deposited by the secondaries in logarithmic bins of the distance
+// to the primary path, plus the energy deposited by the primary itself (the
+// core) and the total primary path length. One instance is held by each Run
+// and merged into the master run.
+
+class RadialDoseProfile
+{
+  public:
+    RadialDoseProfile() = default;
+    ~RadialDoseProfile() = default;
+
+    void SetBinning(G4double rMin, G4double rMax, G4int binsPerDecade);
+    G4bool IsConfigured() const { return !fEnergy.empty(); }
+
+    void Fill(G4double r, G4double edep);
+    void AddCore(G4double edep) { fCoreEnergy += edep; }
+    void AddPathLength(G4double length) { fPathLength += length; }
+
+    void Merge(const RadialDoseProfile&);
+
+    // Writes the energy and the radial dose D(r) = dE / (rho 2 pi r dr L)
+    // of each bin as a text table
+    void Write(const G4String& fileName, G4double density) const;
+
+  private:
+    G4double fLogRMin = 0.;
+    G4double fBinsPerDecade = 1.;
+    std::vector<G4double> fEnergy;
+
+    G4double fUnderflow = 0.;
+    G4double fOverflow = 0.;
+    G4double fCoreEnergy = 0.;
+    G4double fPathLength = 0.;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,117 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file RadialDoseScorer.hh
+/// \brief Definition of the RadialDoseScorer class
+
+#ifndef RadialDoseScorer_h
+#define RadialDoseScorer_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class RadialDoseProfile;
+class RadialDoseMessenger;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Radial dose around the path of the primary (track 1) of each event.
+// The steps of the primary are kept as segments and the deposits of the
+// secondaries as points. At the end of the event each point is binned by
+// its distance to the closest segment. Segments are grouped in chunks with
+// a bounding sphere, and a chunk is only searched if its sphere is closer
+// than the best distance found so far.
+
+class RadialDoseScorer
+{
+  public:
+    RadialDoseScorer();
+    ~RadialDoseScorer();
+
+    void AddPrimarySegment(const G4ThreeVector& start, const G4ThreeVector& end)
+    {
+      fStarts.push_back(start);
+      fEnds.push_back(end);
+    }
+    void AddPrimaryDeposit(G4double edep) { fCoreEnergy += edep; }
+    void AddDeposit(const G4ThreeVector& position, G4double edep)
+    {
+      fPositions.push_back(position);
+      fEnergies.push_back(edep);
+    }
+
+    void BeginOfEvent();
+    void EndOfEvent(RadialDoseProfile&);
+
+    void SetActive(G4bool value) { fActive = value; }
+    void SetBinsPerDecade(G4int value) { fBinsPerDecade = value; }
+
+    G4bool IsActive() const { return fActive; }
+    G4int GetBinsPerDecade() const { return fBinsPerDecade; }
+
+  private:
+    struct Chunk
+    {
+        std::size_t first = 0;
+        std::size_t last = 0;  // one past the last segment
+        G4ThreeVector center;
+        G4double radius = 0.;
+    };
+
+    void BuildChunks();
+    G4double DistanceToSegment(const G4ThreeVector& point, std::size_t segment) const;
+    G4double DistanceToPath(const G4ThreeVector& point) const;
+
+    G4bool fActive = false;
+    G4int fBinsPerDecade = 20;
+
+    // Primary path and secondary deposits of the current event
+    std::vector<G4ThreeVector> fStarts;
+    std::vector<G4ThreeVector> fEnds;
+    G4double fCoreEnergy = 0.;
+    std::vector<G4ThreeVector> fPositions;
+    std::vector<G4double> fEnergies;
+
+    std::vector<Chunk> fChunks;
+    mutable std::vector<std::pair<G4double, std::size_t>> fBounds;  // scratch
+
+    RadialDoseMessenger* fMessenger = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
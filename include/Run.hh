@@ -0,0 +1,154 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file Run.hh
+/// \brief Definition of the Run class
+
+#ifndef Run_h
+#define Run_h 1
+
+#include "DoseMesh.hh"
+#include "LinealEnergySpectrum.hh"
+#include "ProcessProfile.hh"
+#include "RadialDoseProfile.hh"
+
+#include "G4Run.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Per-thread run data, merged into the master run at the end of the run.
+// Worker runs are merged before the worker EndOfRunAction, so everything
+// the master needs is recorded during the event loop.
+
+class Run : public G4Run
+{
+  public:
+    Run();
+    ~Run() override = default;
+
+    void Merge(const G4Run*) override;
+
+    // Output shards written by the threads: thread ID, number of events and
+    // time spent processing them
+    struct Shard
+    {
+        G4int threadID = 0;
+        G4int numberOfEvents = 0;
+        G4double busyTime = 0.;  // seconds
+    };
+    const std::vector<Shard>& GetShards() const { return fShards; }
+
+    LinealEnergySpectrum& GetLinealEnergySpectrum() { return fLinealEnergySpectrum; }
+    const LinealEnergySpectrum& GetLinealEnergySpectrum() const { return fLinealEnergySpectrum; }
+
+    RadialDoseProfile& GetRadialDoseProfile() { return fRadialDoseProfile; }
+    const RadialDoseProfile& GetRadialDoseProfile() const { return fRadialDoseProfile; }
+
+    DoseMesh& GetDoseMesh() { return fDoseMesh; }
+    const DoseMesh& GetDoseMesh() const { return fDoseMesh; }
+
+    ProcessProfile& GetProcessProfile() { return fProcessProfile; }
+    const ProcessProfile& GetProcessProfile() const { return fProcessProfile; }
+
+    // DBSCAN results, summed over the events
+    void AddClusters(G4int clusters, G4int noisePoints)
+    {
+      fNumberOfClusters += clusters;
+      fNumberOfNoisePoints += noisePoints;
+    }
+    G4long GetNumberOfClusters() const { return fNumberOfClusters; }
+    G4long GetNumberOfNoisePoints() const { return fNumberOfNoisePoints; }
+
+    // Time of the events of this thread, from the primary generation to the
+    // end of the event
+    void StartEventTimer() { fEventStart = std::chrono::steady_clock::now(); }
+    void StopEventTimer()
+    {
+      fBusyTime +=
+        std::chrono::duration<G4double>(std::chrono::steady_clock::now() - fEventStart).count();
+    }
+
+    // Multiple ionisations (multiplicity 2-4), with their biasing weights
+    void AddMultipleIonisation(G4int multiplicity, G4double weight)
+    {
+      fMultipleIonisations[multiplicity - 2] += weight;
+      fMultipleIonisations2[multiplicity - 2] += weight * weight;
+    }
+    G4double GetMultipleIonisations(G4int multiplicity) const
+    {
+      return fMultipleIonisations[multiplicity - 2];
+    }
+    G4double GetMultipleIonisations2(G4int multiplicity) const
+    {
+      return fMultipleIonisations2[multiplicity - 2];
+    }
+
+    void CountStep() { ++fNumberOfSteps; }
+    G4long GetNumberOfSteps() const { return fNumberOfSteps; }
+
+    // Events of a resumed run completed before the interruption
+    void SkipEvent() { ++fNumberOfSkippedEvents; }
+    G4int GetNumberOfSkippedEvents() const { return fNumberOfSkippedEvents; }
+
+    // Primaries whose first interaction was sampled directly
+    void AddFirstInteractions(G4int n) { fNumberOfFirstInteractions += n; }
+    G4long GetNumberOfFirstInteractions() const { return fNumberOfFirstInteractions; }
+
+  private:
+    G4int fThreadID = 0;
+    std::vector<Shard> fShards;
+
+    LinealEnergySpectrum fLinealEnergySpectrum;
+    RadialDoseProfile fRadialDoseProfile;
+    DoseMesh fDoseMesh;
+    ProcessProfile fProcessProfile;
+    G4long fNumberOfClusters = 0;
+    G4long fNumberOfNoisePoints = 0;
+    G4long fNumberOfFirstInteractions = 0;
+    G4long fNumberOfSteps = 0;
+    G4double fMultipleIonisations[3] = {0., 0., 0.};
+    G4double fMultipleIonisations2[3] = {0., 0., 0.};  // sums of the squared weights
+    G4int fNumberOfSkippedEvents = 0;
+    G4double fBusyTime = 0.;
+    std::chrono::steady_clock::time_point fEventStart;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
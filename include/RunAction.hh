@@ -39,14 +39,32 @@
 #ifndef RunAction_h
 #define RunAction_h 1
 
+#include "Checkpoint.hh"
+#include "ColumnWriter.hh"
+#include "DamageClusterer.hh"
 #include "DetectorConstruction.hh"
+#include "EventSampler.hh"
+#include "EventSeeder.hh"
+#include "FirstInteractionSampler.hh"
+#include "MicrodosimetryScorer.hh"
+#include "ParameterScan.hh"
+#include "RadialDoseScorer.hh"
+#include "RunCache.hh"
+#include "ShardSelection.hh"
+#include "StepBuffer.hh"
+#include "StepClassifier.hh"
+#include "StepFilter.hh"
 
 #include "G4UserRunAction.hh"
 #include "globals.hh"
 
 #include <iostream>
 
+class DoseMesh;
+class ProcessProfile;
 class G4Run;
+class Run;
+class RunMessenger;
 
 class RunAction : public G4UserRunAction
 {
@@ -54,7 +72,109 @@ class RunAction : public G4UserRunAction
     RunAction();
     virtual ~RunAction();
 
+    virtual G4Run* GenerateRun();
     virtual void BeginOfRunAction(const G4Run*);
     virtual void EndOfRunAction(const G4Run*);
+
+    Run* GetRun() { return fRun; }
+    StepClassifier& GetStepClassifier() { return fStepClassifier; }
+    StepBuffer& GetStepBuffer() { return fStepBuffer; }
+    StepFilter& GetStepFilter() { return fStepFilter; }
+    EventSampler& GetEventSampler() { return fEventSampler; }
+    FirstInteractionSampler& GetFirstInteractionSampler() { return fFirstInteractionSampler; }
+    ColumnWriter& GetTrackWriter() { return fTrackWriter; }
+    MicrodosimetryScorer& GetMicrodosimetryScorer() { return fMicrodosimetryScorer; }
+    DamageClusterer& GetDamageClusterer() { return fDamageClusterer; }
+    RadialDoseScorer& GetRadialDoseScorer() { return fRadialDoseScorer; }
+    RunCache& GetRunCache() { return fRunCache; }
+    EventSeeder& GetEventSeeder() { return fEventSeeder; }
+    Checkpoint& GetCheckpoint() { return fCheckpoint; }
+    ShardSelection& GetShardSelection() { return fShardSelection; }
+    ParameterScan& GetParameterScan() { return fParameterScan; }
+
+    // Output made for the whole run (spectra, profiles, dose mesh, reservoir
+    // sampling), which cannot be extended by the events of another run
+    G4bool HasRunOutput() const
+    {
+      return fMicrodosimetryScorer.IsActive() || fRadialDoseScorer.IsActive() || fDoseMeshActive
+             || fEventSampler.IsHoldingEvents();
+    }
+
+    // Mesh of the current run, nullptr if the dose mesh is not active
+    DoseMesh* GetDoseMesh() { return fDoseMesh; }
+
+    // Profile of the current run, nullptr if the profiling is not active
+    ProcessProfile* GetProcessProfile() { return fProcessProfile; }
+    G4int GetProfileSamplingPeriod() const { return fProfileSamplingPeriod; }
+
+    void SetCompactSchema(G4bool);
+    void SetOutputFormat(const G4String&);
+    G4bool IsColumnarOutput() const { return fColumnarOutput; }
+    G4bool IsHistogramOutput() const { return fHistogramOutput; }
+    void SetNtupleMerging(G4bool merging) { fNtupleMerging = merging; }
+
+    // Row of the track ntuple (or columns)
+    void WriteTrack(const TrackRecord&);
+
+    // Flushes the columns of this thread and records them in its checkpoint
+    void WriteCheckpoint();
+
+    void SetDoseMeshActive(G4bool value) { fDoseMeshActive = value; }
+    void SetVoxelSize(G4double value) { fVoxelSize = value; }
+    void SetSparseDoseMesh(G4bool value) { fSparseDoseMesh = value; }
+
+    void SetProfileActive(G4bool value) { fProfileActive = value; }
+    void SetProfileSamplingPeriod(G4int value) { fProfileSamplingPeriod = value; }
+    void SetProfileJsonFile(const G4String& value) { fProfileJsonFile = value; }
+
+  private:
+    void BookNtuples();
+    void BookHistograms();
+    G4String GetOutputFormat() const;
+    // 3 (default) or 4 (compact); 1 and 2 before the weight column
+    G4int GetSchemaVersion() const { return fCompactSchema ? 4 : 3; }
+    void OpenColumns(const G4String& fileName);
+    void WriteHeldEvents();
+    void WriteMeta(const G4String& fileName, G4int nofEvents);
+    void CloseColumns(const G4String& fileName, G4int nofEvents);
+    void WriteManifest(const G4String& fileName, const G4Run*);
+    void PrintLoadBalance(const G4Run*, G4double runTime) const;
+
+    RunMessenger* fRunMessenger = nullptr;
+    G4bool fCompactSchema = false;
+    G4bool fNtuplesBooked = false;
+    G4bool fColumnarOutput = false;
+    G4bool fHistogramOutput = false;
+    G4bool fNtupleMerging = true;
+    G4double fRunStartTime = 0.;  // seconds since the program start
+    G4double fInitializationTime = -1.;
+    Run* fRun = nullptr;
+
+    G4bool fDoseMeshActive = false;
+    G4double fVoxelSize;
+    G4bool fSparseDoseMesh = true;
+    DoseMesh* fDoseMesh = nullptr;
+
+    G4bool fProfileActive = false;
+    G4int fProfileSamplingPeriod = 16;
+    G4String fProfileJsonFile;
+    ProcessProfile* fProcessProfile = nullptr;
+
+    StepClassifier fStepClassifier;
+    StepBuffer fStepBuffer;
+    StepFilter fStepFilter;
+    EventSampler fEventSampler;
+    FirstInteractionSampler fFirstInteractionSampler;
+    ColumnWriter fStepWriter;
+    ColumnWriter fTrackWriter;
+    ColumnWriter fClusterWriter;
+    MicrodosimetryScorer fMicrodosimetryScorer;
+    DamageClusterer fDamageClusterer;
+    RadialDoseScorer fRadialDoseScorer;
+    RunCache fRunCache;
+    EventSeeder fEventSeeder;
+    Checkpoint fCheckpoint;
+    ShardSelection fShardSelection;
+    ParameterScan fParameterScan;
 };
 #endif
@@ -0,0 +1,115 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file RunCache.hh
+/// \brief Definition of the RunCache class
+
+#ifndef RunCache_h
+#define RunCache_h 1
+
+#include "globals.hh"
+
+#include <string>
+#include <vector>
+
+class RunAction;
+class RunCacheMessenger;
+
+class G4ParticleGun;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Cache of the run output, keyed on the effective configuration
+// (/dna/cache/beamOn N instead of /run/beamOn N).
+// The key is a hash of the Geant4 version, the seeds of the master engine,
+// the material, world size and gun settings, and the UI commands applied so
+// far (geometry, physics, stepping, gun, output...), without the ones that
+// do not change the output (verbosity, visualization, /run/beamOn).
+// The number of events is not part of the key: the runs of a configuration
+// are stored as segments of consecutive events in <directory>/<key>/segN,
+// listed in <directory>/<key>/segments. When the segments hold N events, the
+// output is restored without running; when they hold less, only the missing
+// events are run and stored as a new segment.
+// So that M cached events plus K new ones give the same events as a run of
+// M + K, each event of a cached run is seeded from the key and its global
+// event ID (first event of the segment plus its event ID, see EventSeeder),
+// also written in the output.
+// A single segment is restored as is; several segments are restored as
+// shards listed in dna.manifest, merged with dnamerge.
+
+class RunCache
+{
+  public:
+    RunCache(RunAction*);
+    ~RunCache();
+
+    void SetDirectory(const G4String& value) { fDirectory = value; }
+
+    // Runs nofEvents events, or restores them (master thread)
+    void BeamOn(G4int nofEvents);
+
+    // Configuration hashed into the key, one setting per line
+    std::string GetConfiguration() const;
+    std::string GetKey() const;
+
+    // Seeding of the events of the next run ("none": Geant4 seeding)
+    void SetEventSeeding(const G4String& key, G4int firstEvent);
+
+  private:
+    struct Segment
+    {
+        G4int index = 0;
+        G4int firstEvent = 0;
+        G4int events = 0;
+    };
+
+    std::vector<Segment> ReadSegments(const std::string& directory) const;
+    void WriteSegments(const std::string& directory, const std::vector<Segment>&) const;
+    G4bool Store(const std::string& directory, const Segment&) const;
+    G4bool Restore(const std::string& directory, const std::vector<Segment>&) const;
+
+    RunAction* fRunAction = nullptr;
+    G4String fDirectory = "dna.cache";
+
+    // Copy of the gun on the master thread, which has no primary generator:
+    // the /gun/ commands are then applied (and recorded) on the master too
+    G4ParticleGun* fGun = nullptr;
+
+    RunCacheMessenger* fMessenger = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,81 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ShardLauncher.hh
+/// \brief Definition of the ShardLauncher class
+
+#ifndef ShardLauncher_h
+#define ShardLauncher_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Sharded run: dnaphysics --shards N macro [threads [eventsPerTask]] [--seed S]
+// Runs the macro in N local processes (POSIX), each in dna.shards/shard<k>
+// with its log in dnaphysics.out, its own thread pool (by default the cores
+// divided between the processes) and, on Linux, its own block of cores.
+// Process k runs its part of the events of each run (see ShardSelection),
+// all seeded from S (drawn and printed if not given), so that a sharded run
+// is reproducible and gives the same events whatever the number of shards.
+// When all the processes succeed, their outputs are moved to the working
+// directory as shards dna_s<k>..., listed in dna.manifest, and merged with
+// dnamerge; their dose meshes are summed into dna.dose. The lineal energy
+// and radial dose scorers are refused in the processes (see RunAction).
+
+class ShardLauncher
+{
+  public:
+    ShardLauncher(G4int nofShards, std::uint64_t seed);
+    ~ShardLauncher() = default;
+
+    // Arguments of dnaphysics without --shards and --seed; returns the exit
+    // code of dnaphysics
+    G4int Run(const std::vector<std::string>& arguments);
+
+  private:
+    G4bool Merge(const std::string& executable) const;
+
+    G4int fNumberOfShards = 1;
+    std::uint64_t fSeed = 0;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
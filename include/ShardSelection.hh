@@ -0,0 +1,93 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ShardSelection.hh
+/// \brief Definition of the ShardSelection class
+
+#ifndef ShardSelection_h
+#define ShardSelection_h 1
+
+#include "EventSeeder.hh"
+
+#include "globals.hh"
+
+#include <cstdint>
+
+class RunAction;
+class ShardMessenger;
+
+class G4Run;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Part of the events of each run processed by one of the N processes of a
+// sharded run (/dna/shard/select, set by: dnaphysics --shards N macro).
+// The events of run r are seeded from the seed of the sharded run and r
+// (see EventSeeder): process k of N runs the global events
+// [k n / N, (k + 1) n / N) of a run of n events and skips the others, so
+// that the N processes give the same events as one process with the same
+// seed, whatever N.
+
+class ShardSelection
+{
+  public:
+    ShardSelection(RunAction*);
+    ~ShardSelection();
+
+    void Select(G4int index, G4int nofShards, std::uint64_t seed);
+
+    G4bool IsActive() const { return fActive; }
+    G4int GetIndex() const { return fIndex; }
+    G4int GetNumberOfShards() const { return fNumberOfShards; }
+
+    void BeginOfRun(const G4Run*);
+    void EndOfRun(const G4Run*);
+
+  private:
+    RunAction* fRunAction = nullptr;
+    G4bool fActive = false;
+    G4int fIndex = 0;
+    G4int fNumberOfShards = 1;
+    std::uint64_t fSeed = 0;
+
+    // Seeding before the run, restored at its end
+    EventSeeder fSavedSeeder;
+
+    ShardMessenger* fMessenger = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,118 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file StepBuffer.hh
+/// \brief Definition of the StepBuffer class
+
+#ifndef StepBuffer_h
+#define StepBuffer_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+class ColumnWriter;
+class G4Step;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Per-thread struct-of-arrays buffer of recorded steps.
+// SteppingAction only stores the raw pre/post step point data; the derived
+// columns (step length, energy difference, cosTheta, unit conversions) are
+// computed block-wise in Flush(), which then hands the whole block to the
+// output: the step ntuple, or a ColumnWriter when the columnar format is
+// selected. The buffer is flushed at the end of each event and whenever it
+// is full, unless it holds whole events for the reservoir sampling (see
+// EventSampler), in which case it grows instead.
+
+class StepBuffer
+{
+  public:
+    StepBuffer(std::size_t capacity = 4096);
+    ~StepBuffer() = default;
+
+    void Add(const G4Step*, G4int flagParticle, G4int flagProcess, G4double weight);
+    void Flush();
+
+    void SetEventID(G4int eventID) { fEventID = eventID; }
+    void SetHold(G4bool hold) { fHold = hold; }
+    void Clear() { fSize = 0; }
+    void SwapRows(StepBuffer&);
+    void SetCompactSchema(G4bool compact) { fCompactSchema = compact; }
+    void SetColumnWriter(ColumnWriter* writer) { fColumnWriter = writer; }
+    std::size_t GetSize() const { return fSize; }
+    std::size_t GetCapacity() const { return fCapacity; }
+
+    // Output statistics, reset with ResetStatistics()
+    std::size_t GetRowsWritten() const { return fRowsWritten; }
+    G4double GetWriteTime() const { return fWriteTime; }
+    void ResetStatistics();
+
+  private:
+    void Resize(std::size_t capacity);
+    void ComputeDerivedColumns();
+    void WriteBlock();
+    void WriteColumns();
+
+    std::size_t fCapacity = 0;
+    std::size_t fSize = 0;
+    G4int fEventID = 0;
+    G4bool fCompactSchema = false;
+    G4bool fHold = false;
+    ColumnWriter* fColumnWriter = nullptr;
+
+    std::size_t fRowsWritten = 0;
+    G4double fWriteTime = 0.;  // seconds
+
+    // Raw step data, in Geant4 internal units
+    std::vector<G4int> fFlagParticle;
+    std::vector<G4int> fFlagProcess;
+    std::vector<G4double> fPreX, fPreY, fPreZ;
+    std::vector<G4double> fPostX, fPostY, fPostZ;
+    std::vector<G4double> fPreDirX, fPreDirY, fPreDirZ;
+    std::vector<G4double> fPostDirX, fPostDirY, fPostDirZ;
+    std::vector<G4double> fEnergyDeposit;
+    std::vector<G4double> fPreKineticEnergy;
+    std::vector<G4double> fPostKineticEnergy;
+    std::vector<G4int> fEventIDs, fTrackID, fParentID, fStepID;
+    std::vector<G4double> fWeight;
+
+    // Derived columns, in output units (nm, eV)
+    std::vector<G4double> fStepLength;
+    std::vector<G4double> fKineticEnergyDifference;
+    std::vector<G4double> fCosTheta;
+};
+
+#endif
@@ -0,0 +1,191 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file StepClassifier.hh
+/// \brief Definition of the StepClassifier class
+
+#ifndef StepClassifier_h
+#define StepClassifier_h 1
+
+#include "EnergyWindowProcess.hh"
+
+#include "G4Step.hh"
+#include "G4VProcess.hh"
+#include "globals.hh"
+
+#include <array>
+
+class G4ParticleDefinition;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Maps (particle definition, process sub-type) pairs to the flagParticle
+// and flagProcess codes listed in the README.
+// The capture and multiple ionisation processes, which have no sub-type of
+// their own, are matched by address instead.
+// The table is built once per thread at the beginning of each run, so that
+// no string comparison or ion lookup is performed during tracking.
+
+class StepClassifier
+{
+  public:
+    StepClassifier() = default;
+    ~StepClassifier() = default;
+
+    void Build();
+
+    inline G4int ParticleFlag(const G4ParticleDefinition*);
+    inline G4int ProcessFlag(G4int particleFlag, const G4VProcess*) const;
+    inline G4bool IsTransportation(const G4VProcess*) const;
+
+    // Multiplicity (2-4) of a multiple ionisation flagProcess, else 0
+    static inline G4int Multiplicity(G4int flagProcess);
+
+    // Weight of a step: the track weight, or the weight of the interaction
+    // of a (biased) multiple ionisation
+    static inline G4double StepWeight(const G4Step*, G4int flagProcess);
+
+    // Kinetic energy and direction after a step: those of the post-step
+    // point, or, when the roulette of a biased multiple ionisation undid the
+    // change of the primary, those proposed by the interaction
+    static inline void PostStepChange(const G4Step*, G4int flagProcess, G4double& kineticEnergy,
+                                      G4ThreeVector& direction);
+
+    static constexpr G4int kNParticles = 8;
+    static constexpr G4int kNSubTypes = 256;
+
+  private:
+    G4int ClassifyParticle(const G4ParticleDefinition*) const;
+    G4int SubTypeCode(G4int particleFlag, G4int subType) const;
+    G4int MultipleIonisationCode(G4int particleFlag, const G4String& processName) const;
+
+    // gamma, e-, proton, hydrogen, alpha, alpha+, helium (index = flag)
+    std::array<const G4ParticleDefinition*, kNParticles - 1> fDefinitions{};
+
+    const G4ParticleDefinition* fLastDefinition = nullptr;
+    G4int fLastFlag = -1;
+
+    // Capture has no sub-type and is identified by its address
+    const G4VProcess* fCapture = nullptr;
+
+    // Double, triple and quadruple ionisation of each particle, identified
+    // by address as well (see Build)
+    std::array<std::array<const G4VProcess*, 3>, kNParticles> fMultipleIonisations{};
+
+    std::array<G4int, kNParticles * kNSubTypes> fProcessTable{};
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4int StepClassifier::ParticleFlag(const G4ParticleDefinition* partDef)
+{
+  // Consecutive steps and tracks mostly share the same definition
+  if (partDef != fLastDefinition) {
+    fLastDefinition = partDef;
+    fLastFlag = ClassifyParticle(partDef);
+  }
+  return fLastFlag;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4int StepClassifier::ProcessFlag(G4int particleFlag, const G4VProcess* process) const
+{
+  if (particleFlag < 0) return -1;
+  if (particleFlag == 7 && process == fCapture) return 1;
+
+  const auto& multipleIonisations = fMultipleIonisations[particleFlag];
+  for (G4int m = 0; m < 3; ++m) {
+    if (process == multipleIonisations[m]) return particleFlag * 10 + 6 + m;
+  }
+
+  G4int subType = process->GetProcessSubType();
+  if (subType < 0 || subType >= kNSubTypes) return -1;
+
+  return fProcessTable[particleFlag * kNSubTypes + subType];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4bool StepClassifier::IsTransportation(const G4VProcess* process) const
+{
+  return process->GetProcessType() == fTransportation;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4int StepClassifier::Multiplicity(G4int flagProcess)
+{
+  // e.g. 26: double ionisation of a proton, 78: quadruple of a generic ion
+  if (flagProcess < 20 || flagProcess >= 100) return 0;
+  G4int offset = flagProcess % 10;
+  return (offset >= 6 && offset <= 8) ? offset - 4 : 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4double StepClassifier::StepWeight(const G4Step* step, G4int flagProcess)
+{
+  // Multiple ionisation processes are registered wrapped in an
+  // EnergyWindowProcess (see PhysicsList::ConstructMultipleIonisationProcess)
+  if (Multiplicity(flagProcess) > 0) {
+    auto process = dynamic_cast<const EnergyWindowProcess*>(
+      step->GetPostStepPoint()->GetProcessDefinedStep());
+    if (process != nullptr) return process->GetInteractionWeight();
+  }
+  return step->GetTrack()->GetWeight();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void StepClassifier::PostStepChange(const G4Step* step, G4int flagProcess,
+                                           G4double& kineticEnergy, G4ThreeVector& direction)
+{
+  const G4StepPoint* postStep = step->GetPostStepPoint();
+  if (Multiplicity(flagProcess) > 0) {
+    auto process = dynamic_cast<const EnergyWindowProcess*>(postStep->GetProcessDefinedStep());
+    if (process != nullptr && process->IsChangeRestored()) {
+      kineticEnergy = process->GetInteractionKineticEnergy();
+      direction = process->GetInteractionDirection();
+      return;
+    }
+  }
+  kineticEnergy = postStep->GetKineticEnergy();
+  direction = postStep->GetMomentumDirection();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
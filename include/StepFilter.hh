@@ -0,0 +1,120 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file StepFilter.hh
+/// \brief Definition of the StepFilter class
+
+#ifndef StepFilter_h
+#define StepFilter_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <bitset>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// Selection of the recorded steps, set with the /step/filter/ commands.
+// The rules are only collected by the commands; Compile(), called at the
+// beginning of each run, turns them into flag lookup tables and a mask of
+// the active tests, so that Accept() costs a few comparisons per step.
+// A step is recorded if it passes all the active tests:
+//  - its particle flag is one of the selected particle flags,
+//  - its process flag is one of the selected process flags,
+//  - its kinetic energy at the PreStepPoint is in the energy window,
+//  - its PostStepPoint lies in at least one of the boxes.
+
+class StepFilter
+{
+  public:
+    StepFilter() = default;
+    ~StepFilter() = default;
+
+    // Rules
+    void SetParticles(const std::vector<G4int>& flags) { fParticles = flags; }
+    void SetProcesses(const std::vector<G4int>& flags) { fProcesses = flags; }
+    void SetEnergyWindow(G4double min, G4double max);
+    void AddBox(const G4ThreeVector& corner1, const G4ThreeVector& corner2);
+    void Clear();
+
+    void Compile();
+
+    G4bool Accept(G4int flagParticle, G4int flagProcess, G4double kineticEnergy,
+                  const G4ThreeVector& position) const
+    {
+      if (fTests == 0) return true;
+      if ((fTests & kParticle) && !fParticleTable.test(flagParticle & kFlagMask)) return false;
+      if ((fTests & kProcess) && !fProcessTable.test(flagProcess & kFlagMask)) return false;
+      if ((fTests & kEnergy) && (kineticEnergy < fEnergyMin || kineticEnergy >= fEnergyMax))
+        return false;
+      if (fTests & kBox) return InBoxes(position);
+      return true;
+    }
+
+    G4bool IsActive() const { return fTests != 0; }
+    void Print() const;
+
+  private:
+    enum Test : unsigned
+    {
+      kParticle = 1,
+      kProcess = 2,
+      kEnergy = 4,
+      kBox = 8
+    };
+
+    // Flags are below 1024 (see StepClassifier)
+    static constexpr G4int kFlagMask = 1023;
+
+    G4bool InBoxes(const G4ThreeVector& position) const;
+
+    // Rules set by the commands
+    std::vector<G4int> fParticles;
+    std::vector<G4int> fProcesses;
+    G4bool fEnergyWindowSet = false;
+    G4double fEnergyMin = 0.;
+    G4double fEnergyMax = 0.;
+    std::vector<G4double> fBoxes;  // xmin, ymin, zmin, xmax, ymax, zmax per box
+
+    // Compiled predicate
+    unsigned fTests = 0;
+    std::bitset<1024> fParticleTable;
+    std::bitset<1024> fProcessTable;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -42,21 +42,38 @@
 #include "G4UserSteppingAction.hh"
 #include "globals.hh"
 
+class ProcessProfile;
+class RunAction;
+class StepFilter;
 class SteppingMessenger;
 
 class SteppingAction : public G4UserSteppingAction
 {
   public:
-    SteppingAction();
+    SteppingAction(RunAction*);
     virtual ~SteppingAction();
 
     virtual void UserSteppingAction(const G4Step*);
 
     void SetKillStatus(G4int value) { fKill = value; };
+    G4int GetKillStatus() const { return fKill; }
+
+    // Called at the beginning of each event, so that the time spent between
+    // events and runs (output, scorers, table builds) is not charged to a step
+    void ResetProfileTimer() { fProfileTimed = false; }
+    StepFilter& GetStepFilter();
 
   private:
+    void FillHistograms(const G4Step*, G4int flagProcess, G4double weight);
+    void Profile(const G4Step*, ProcessProfile&);
+
+    RunAction* fRunAction = nullptr;
     G4int fKill = 0;
     SteppingMessenger* fSteppingMessenger = nullptr;
 
+    // Sampled step timing (see ProcessProfile)
+    G4long fProfileCounter = 0;
+    G4bool fProfileTimed = false;
+    G4double fProfileTime = 0.;  // thread CPU time, seconds
 };
 #endif
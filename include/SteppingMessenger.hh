@@ -46,6 +46,9 @@ class SteppingAction;
 
 class G4UIdirectory;
 class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+class G4UIcmdWithoutParameter;
+class G4UIcommand;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -62,6 +65,13 @@ class SteppingMessenger : public G4UImessenger
 
     G4UIdirectory* fStepDir = nullptr;
     G4UIcmdWithAnInteger* fKillCmd = nullptr;
+
+    G4UIdirectory* fFilterDir = nullptr;
+    G4UIcmdWithAString* fParticleCmd = nullptr;
+    G4UIcmdWithAString* fProcessCmd = nullptr;
+    G4UIcommand* fEnergyCmd = nullptr;
+    G4UIcommand* fBoxCmd = nullptr;
+    G4UIcmdWithoutParameter* fClearCmd = nullptr;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -42,14 +42,19 @@
 #include "G4UserTrackingAction.hh"
 #include "globals.hh"
 
+class RunAction;
+
 class TrackingAction : public G4UserTrackingAction
 {
   public:
-    TrackingAction();
+    TrackingAction(RunAction*);
     ~TrackingAction() override = default;
 
     void PreUserTrackingAction(const G4Track*) override;
     void PostUserTrackingAction(const G4Track*) override;
+
+  private:
+    RunAction* fRunAction = nullptr;
 };
 
 #endif
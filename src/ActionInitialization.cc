@@ -38,6 +38,7 @@
 
 #include "ActionInitialization.hh"
 
+#include "EventAction.hh"
 #include "PrimaryGeneratorAction.hh"
 #include "RunAction.hh"
 #include "SteppingAction.hh"
@@ -62,13 +63,17 @@ void ActionInitialization::BuildForMaster() const
 
 void ActionInitialization::Build() const
 {
-  SetUserAction(new PrimaryGeneratorAction);
-
   RunAction* runAction = new RunAction();
   SetUserAction(runAction);
 
-  TrackingAction* trackingAction = new TrackingAction();
+  SetUserAction(new PrimaryGeneratorAction(runAction));
+
+  SteppingAction* steppingAction = new SteppingAction(runAction);
+
+  SetUserAction(new EventAction(runAction, steppingAction));
+
+  TrackingAction* trackingAction = new TrackingAction(runAction);
   SetUserAction(trackingAction);
 
-  SetUserAction(new SteppingAction());
+  SetUserAction(steppingAction);
 }
@@ -0,0 +1,426 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file Checkpoint.cc
+/// \brief Implementation of the Checkpoint class
+
+#include "Checkpoint.hh"
+#include "CheckpointMessenger.hh"
+
+#include "ColumnFormat.hh"
+#include "RunAction.hh"
+
+#include "G4Run.hh"
+#include "G4Threading.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+const char* const kDirectory = "dna.checkpoint";
+
+// Tables of a shard; the meta table is rewritten at each checkpoint
+const char* const kTables[4] = {"step", "track", "cluster", "meta"};
+
+// Event IDs as ranges, e.g. "0-99 150 200-250"
+std::string FormatRanges(std::vector<G4int> eventIDs)
+{
+  std::sort(eventIDs.begin(), eventIDs.end());
+  std::ostringstream ranges;
+  for (std::size_t i = 0; i < eventIDs.size();) {
+    std::size_t j = i;
+    while (j + 1 < eventIDs.size() && eventIDs[j + 1] == eventIDs[j] + 1) {
+      ++j;
+    }
+    if (i > 0) ranges << ' ';
+    ranges << eventIDs[i];
+    if (j > i) ranges << '-' << eventIDs[j];
+    i = j + 1;
+  }
+  return ranges.str();
+}
+
+std::vector<G4int> ParseRanges(std::istream& ranges)
+{
+  std::vector<G4int> eventIDs;
+  std::string range;
+  while (ranges >> range) {
+    std::size_t dash = range.find('-');
+    G4int first = std::atoi(range.c_str());
+    G4int last = (dash == std::string::npos) ? first : std::atoi(range.c_str() + dash + 1);
+    for (G4int eventID = first; eventID <= last; ++eventID) {
+      eventIDs.push_back(eventID);
+    }
+  }
+  return eventIDs;
+}
+
+// The file is replaced at once, so that an interruption leaves the previous one
+void WriteFile(const fs::path& path, const std::string& content)
+{
+  fs::path temporary = path;
+  temporary += ".tmp";
+  {
+    std::ofstream file(temporary);
+    file << content;
+  }
+  fs::rename(temporary, path);
+}
+
+// Cuts the column files of a table to their first rows
+void CutColumns(const fs::path& table, std::uint64_t rows)
+{
+  for (const auto& entry : fs::directory_iterator(table)) {
+    if (entry.path().extension() != ".col") continue;
+    std::FILE* file = std::fopen(entry.path().string().c_str(), "r+b");
+    if (file == nullptr) continue;
+    ColumnHeader header;
+    G4bool valid = (std::fread(&header, sizeof(header), 1, file) == 1);
+    if (valid) {
+      header.rows = rows;
+      std::fseek(file, 0, SEEK_SET);
+      std::fwrite(&header, sizeof(header), 1, file);
+    }
+    std::fclose(file);
+    if (valid) fs::resize_file(entry.path(), sizeof(ColumnHeader) + rows * header.width);
+  }
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+Checkpoint::Checkpoint(RunAction* runAction) : fRunAction(runAction)
+{
+  fMessenger = new CheckpointMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+Checkpoint::~Checkpoint()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int Checkpoint::GetNumberOfRecoveredEvents() const
+{
+  G4int events = 0;
+  for (const auto& shard : fRecoveredShards) {
+    events += (G4int)shard.events.size();
+  }
+  return events;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void Checkpoint::Resume()
+{
+  fs::path directory(kDirectory);
+  std::ifstream run(directory / "run");
+  if (!run) {
+    G4cout << "--- Checkpoint: nothing to resume (no " << kDirectory << "/run)" << G4endl;
+    return;
+  }
+
+  fPendingCount = -1;
+  std::string line;
+  while (std::getline(run, line)) {
+    std::istringstream tokens(line);
+    std::string key;
+    tokens >> key;
+    if (key == "run") tokens >> fPendingRunID;
+    if (key == "events") tokens >> fPendingEvents;
+    if (key == "seed") tokens >> std::hex >> fPendingSeed;
+    if (key == "first") tokens >> fPendingFirstEvent;
+    if (key == "count") tokens >> fPendingCount;
+    if (key == "attempt") tokens >> fPendingAttempt;
+  }
+  if (fPendingCount < 0) fPendingCount = fPendingEvents;
+
+  // Shards of the interrupted attempts, cut to their last checkpoint and
+  // kept in dna.checkpoint/columns until their run comes
+  fRecoveredShards.clear();
+  try {
+    fs::create_directories(directory / "columns");
+    for (const auto& entry : fs::directory_iterator(directory)) {
+      std::string name = entry.path().filename().string();
+      if (name.rfind("shard", 0) != 0 || entry.path().extension() == ".tmp") continue;
+
+      Shard shard;
+      std::ifstream file(entry.path());
+      while (std::getline(file, line)) {
+        std::istringstream tokens(line);
+        std::string key;
+        tokens >> key;
+        if (key == "thread") tokens >> shard.threadID;
+        if (key == "suffix") tokens >> shard.suffix;
+        if (key == "rows") tokens >> shard.rows[0] >> shard.rows[1] >> shard.rows[2];
+        if (key == "events") shard.events = ParseRanges(tokens);
+      }
+
+      for (G4int k = 0; k < 4; ++k) {
+        fs::path table = fs::path("dna.columns") / (kTables[k] + shard.suffix);
+        if (!fs::is_directory(table)) continue;
+        fs::path kept = directory / "columns" / table.filename();
+        fs::remove_all(kept);
+        fs::rename(table, kept);
+        if (k < 3) CutColumns(kept, shard.rows[k]);
+      }
+      fRecoveredShards.push_back(shard);
+    }
+  }
+  catch (const fs::filesystem_error& error) {
+    G4ExceptionDescription description;
+    description << "Cannot recover the shards of " << kDirectory << ": " << error.what();
+    G4Exception("Checkpoint::Resume()", "dnaphysics009", JustWarning, description);
+    fRecoveredShards.clear();
+    return;
+  }
+
+  fResumePending = true;
+  G4cout << "--- Checkpoint: run " << fPendingRunID << " will be resumed, "
+         << GetNumberOfRecoveredEvents() << " of its " << fPendingEvents
+         << " events completed in " << fRecoveredShards.size() << " shards" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void Checkpoint::BeginOfRun(const G4Run* aRun)
+{
+  fSavedSeeder = fRunAction->GetEventSeeder();
+  fActive = false;
+  fShardTag = "";
+  fCompletedEvents.clear();
+  fEventsSinceCheckpoint = 0;
+  if (fInterval <= 0) return;
+
+  G4bool master = G4Threading::IsMasterThread();
+  if (!fRunAction->IsColumnarOutput() || fRunAction->HasRunOutput()) {
+    if (master) {
+      G4Exception("Checkpoint::BeginOfRun()", "dnaphysics009", JustWarning,
+                  "Checkpoints need the columnar output, without the lineal energy, radial "
+                  "dose and dose mesh scorers and the reservoir sampling; this run has none.");
+    }
+    return;
+  }
+
+  // The master prepares dna.checkpoint/run, read by all the threads
+  if (master) BeginOfMasterRun(aRun->GetRunID(), aRun->GetNumberOfEventToBeProcessed());
+  ReadRun(aRun->GetRunID());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void Checkpoint::BeginOfMasterRun(G4int runID, G4int nofEvents)
+{
+  // Runs of the macro before the interrupted one: no checkpoint
+  if (fResumePending && runID < fPendingRunID) return;
+
+  fs::path directory(kDirectory);
+  std::ostringstream run;
+  run << "# dnaphysics checkpoint" << '\n';
+  run << "run " << runID << '\n';
+  run << "events " << nofEvents << '\n';
+
+  try {
+    if (fResumePending && runID == fPendingRunID && nofEvents == fPendingEvents) {
+      // Shards of the interrupted attempts back in dna.columns
+      fs::create_directories("dna.columns");
+      for (const auto& entry : fs::directory_iterator(directory / "columns")) {
+        fs::rename(entry.path(), fs::path("dna.columns") / entry.path().filename());
+      }
+
+      // Events left to do
+      std::vector<char> done(fPendingCount, 0);
+      for (const auto& shard : fRecoveredShards) {
+        for (G4int eventID : shard.events) {
+          G4int i = eventID - fPendingFirstEvent;
+          if (i >= 0 && i < fPendingCount) done[i] = 1;
+        }
+      }
+      std::vector<G4int> todo;
+      for (G4int i = 0; i < fPendingCount; ++i) {
+        if (done[i] == 0) todo.push_back(fPendingFirstEvent + i);
+      }
+
+      run << "seed " << std::hex << fPendingSeed << std::dec << '\n';
+      run << "first " << fPendingFirstEvent << '\n';
+      run << "count " << fPendingCount << '\n';
+      run << "attempt " << fPendingAttempt + 1 << '\n';
+      run << "todo " << FormatRanges(todo) << '\n';
+      G4cout << "--- Checkpoint: resuming run " << runID << ", " << fPendingCount - todo.size()
+             << " events completed, " << todo.size() << " to run" << G4endl;
+    }
+    else {
+      if (fResumePending) {
+        G4Exception("Checkpoint::BeginOfMasterRun()", "dnaphysics009", JustWarning,
+                    "The run differs from the interrupted one; it is run from the start.");
+      }
+      fs::remove_all(directory);
+      fRecoveredShards.clear();
+
+      // Seed of a cached run, or drawn from the master engine
+      const EventSeeder& seeder = fRunAction->GetEventSeeder();
+      std::uint64_t seed = seeder.GetSeed();
+      if (!seeder.IsActive()) {
+        seed = ((std::uint64_t)(G4UniformRand() * 4294967296.) << 32)
+               ^ (std::uint64_t)(G4UniformRand() * 4294967296.);
+        seed |= 1;
+      }
+      run << "seed " << std::hex << seed << std::dec << '\n';
+      // Events of this process (see ShardSelection)
+      G4int count = seeder.GetNumberOfEvents();
+      run << "first " << seeder.GetFirstEvent() << '\n';
+      run << "count " << (count < 0 ? nofEvents : count) << '\n';
+      run << "attempt 0" << '\n';
+    }
+    fResumePending = false;
+
+    fs::create_directories(directory);
+    WriteFile(directory / "run", run.str());
+  }
+  catch (const fs::filesystem_error& error) {
+    G4ExceptionDescription description;
+    description << "Cannot prepare " << kDirectory << ": " << error.what();
+    G4Exception("Checkpoint::BeginOfMasterRun()", "dnaphysics009", JustWarning, description);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool Checkpoint::ReadRun(G4int runID)
+{
+  std::ifstream file(fs::path(kDirectory) / "run");
+  if (!file) return false;
+
+  G4int fileRunID = -1;
+  std::uint64_t seed = 0;
+  G4int firstEvent = 0;
+  G4int count = -1;
+  G4int attempt = 0;
+  G4bool resumed = false;
+  std::vector<G4int> todo;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream tokens(line);
+    std::string key;
+    tokens >> key;
+    if (key == "run") tokens >> fileRunID;
+    if (key == "seed") tokens >> std::hex >> seed;
+    if (key == "first") tokens >> firstEvent;
+    if (key == "count") tokens >> count;
+    if (key == "attempt") tokens >> attempt;
+    if (key == "todo") {
+      todo = ParseRanges(tokens);
+      resumed = true;
+    }
+  }
+  if (fileRunID != runID || seed == 0) return false;
+
+  EventSeeder& seeder = fRunAction->GetEventSeeder();
+  seeder.SetSeed(seed);
+  seeder.SetFirstEvent(firstEvent);
+  seeder.SetNumberOfEvents(count);
+  if (resumed) seeder.SetEventIDs(todo);
+
+  fShardTag = "_r" + std::to_string(attempt);
+  fActive = true;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool Checkpoint::EndOfEvent(G4int globalEventID)
+{
+  if (!fActive) return false;
+  fCompletedEvents.push_back(globalEventID);
+  return ++fEventsSinceCheckpoint >= fInterval;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void Checkpoint::Write(std::uint64_t stepRows, std::uint64_t trackRows,
+                       std::uint64_t clusterRows)
+{
+  fEventsSinceCheckpoint = 0;
+
+  G4int threadID = G4Threading::G4GetThreadId();
+  G4String suffix = fShardTag;
+  if (G4Threading::IsMultithreadedApplication()) suffix += "_t" + std::to_string(threadID);
+
+  std::ostringstream shard;
+  shard << "thread " << threadID << '\n';
+  shard << "suffix " << suffix << '\n';
+  shard << "rows " << stepRows << ' ' << trackRows << ' ' << clusterRows << '\n';
+  shard << "events " << FormatRanges(fCompletedEvents) << '\n';
+
+  try {
+    WriteFile(fs::path(kDirectory) / ("shard" + suffix), shard.str());
+  }
+  catch (const fs::filesystem_error& error) {
+    G4ExceptionDescription description;
+    description << "Cannot write the checkpoint: " << error.what();
+    G4Exception("Checkpoint::Write()", "dnaphysics009", JustWarning, description);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void Checkpoint::EndOfRun(const G4Run* aRun)
+{
+  fRunAction->GetEventSeeder() = fSavedSeeder;
+  if (!fActive) return;
+  fActive = false;
+
+  // A complete run needs no checkpoint
+  if (G4Threading::IsMasterThread()
+      && aRun->GetNumberOfEvent() == aRun->GetNumberOfEventToBeProcessed())
+  {
+    std::error_code error;
+    fs::remove_all(kDirectory, error);
+    fRecoveredShards.clear();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
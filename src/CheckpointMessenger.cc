@@ -0,0 +1,90 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file CheckpointMessenger.cc
+/// \brief Implementation of the CheckpointMessenger class
+
+#include "CheckpointMessenger.hh"
+#include "Checkpoint.hh"
+
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIdirectory.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CheckpointMessenger::CheckpointMessenger(Checkpoint* checkpoint) : fCheckpoint(checkpoint)
+{
+  fCheckpointDir = new G4UIdirectory("/dna/checkpoint/");
+  fCheckpointDir->SetGuidance("checkpoints of the columnar output, to resume interrupted runs");
+
+  fIntervalCmd = new G4UIcmdWithAnInteger("/dna/checkpoint/interval", this);
+  fIntervalCmd->SetGuidance("Events between two checkpoints of each thread (0: none, default).");
+  fIntervalCmd->SetGuidance("Needs the columnar output, without the lineal energy, radial");
+  fIntervalCmd->SetGuidance("dose and dose mesh scorers and the reservoir sampling.");
+  fIntervalCmd->SetParameterName("events", false);
+  fIntervalCmd->SetRange("events>=0");
+  fIntervalCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fResumeCmd = new G4UIcmdWithoutParameter("/dna/checkpoint/resume", this);
+  fResumeCmd->SetGuidance("Resume the interrupted run of dna.checkpoint when it comes");
+  fResumeCmd->SetGuidance("(set by the --resume option of dnaphysics).");
+  fResumeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fResumeCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CheckpointMessenger::~CheckpointMessenger()
+{
+  delete fIntervalCmd;
+  delete fResumeCmd;
+  delete fCheckpointDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CheckpointMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fIntervalCmd) {
+    fCheckpoint->SetInterval(fIntervalCmd->GetNewIntValue(newValue));
+  }
+
+  if (command == fResumeCmd) {
+    fCheckpoint->Resume();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,172 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ColumnWriter.cc
+/// \brief Implementation of the ColumnWriter class
+
+#include "ColumnWriter.hh"
+
+#include <cstring>
+#include <filesystem>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ColumnWriter::~ColumnWriter()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnWriter::Open(const G4String& directory)
+{
+  Close();
+
+  std::error_code error;
+  std::filesystem::create_directories(directory.c_str(), error);
+  if (error) {
+    G4ExceptionDescription description;
+    description << "Cannot create output directory " << directory << ": " << error.message();
+    G4Exception("ColumnWriter::Open()", "dnaphysics003", FatalException, description);
+  }
+
+  fDirectory = directory;
+  fBytesWritten = 0;
+  fOpen = true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int ColumnWriter::AddColumn(const G4String& name, ColumnType type)
+{
+  G4String path = fDirectory + "/" + name + ".col";
+
+  Column column;
+  column.type = type;
+  column.file = std::fopen(path.c_str(), "wb");
+  if (column.file == nullptr) {
+    G4ExceptionDescription description;
+    description << "Cannot open column file " << path;
+    G4Exception("ColumnWriter::AddColumn()", "dnaphysics003", FatalException, description);
+    return -1;
+  }
+  std::setvbuf(column.file, nullptr, _IOFBF, 1 << 20);
+
+  ColumnHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kColumnMagic, sizeof(header.magic));
+  header.version = kColumnFormatVersion;
+  header.type = type;
+  header.width = ColumnWidth(type);
+  std::strncpy(header.name, name.c_str(), sizeof(header.name) - 1);
+  std::fwrite(&header, sizeof(header), 1, column.file);
+  fBytesWritten += sizeof(header);
+
+  fColumns.push_back(column);
+  return (G4int)fColumns.size() - 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnWriter::Close()
+{
+  for (auto& column : fColumns) {
+    std::fseek(column.file, (long)kColumnRowsOffset, SEEK_SET);
+    std::fwrite(&column.rows, sizeof(column.rows), 1, column.file);
+    std::fclose(column.file);
+  }
+  fColumns.clear();
+  fOpen = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnWriter::Flush()
+{
+  for (auto& column : fColumns) {
+    std::fseek(column.file, (long)kColumnRowsOffset, SEEK_SET);
+    std::fwrite(&column.rows, sizeof(column.rows), 1, column.file);
+    std::fseek(column.file, 0, SEEK_END);
+    std::fflush(column.file);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnWriter::WriteRaw(Column& column, const void* data, std::size_t n)
+{
+  std::size_t width = ColumnWidth(column.type);
+  std::fwrite(data, width, n, column.file);
+  column.rows += n;
+  fBytesWritten += width * n;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnWriter::Write(G4int index, const G4int* values, std::size_t n)
+{
+  Column& column = fColumns[index];
+  if (column.type != kColumnInt32) {
+    G4Exception("ColumnWriter::Write()", "dnaphysics003", FatalException,
+                "Integer values written to a floating point column.");
+    return;
+  }
+  WriteRaw(column, values, n);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ColumnWriter::Write(G4int index, const G4double* values, std::size_t n)
+{
+  Column& column = fColumns[index];
+  if (column.type == kColumnFloat64) {
+    WriteRaw(column, values, n);
+    return;
+  }
+
+  if (column.type == kColumnFloat32) {
+    fScratch.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      fScratch[i] = (float)values[i];
+    }
+    WriteRaw(column, fScratch.data(), n);
+    return;
+  }
+
+  G4Exception("ColumnWriter::Write()", "dnaphysics003", FatalException,
+              "Floating point values written to an int32 column.");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
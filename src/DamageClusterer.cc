@@ -0,0 +1,210 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file DamageClusterer.cc
+/// \brief Implementation of the DamageClusterer class
+
+#include "DamageClusterer.hh"
+
+#include "ColumnWriter.hh"
+#include "DamageClustererMessenger.hh"
+
+#include "G4AnalysisManager.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DamageClusterer::DamageClusterer() : fEpsilon(3.2 * nm)
+{
+  fMessenger = new DamageClustererMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DamageClusterer::~DamageClusterer()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DamageClusterer::BeginOfEvent()
+{
+  fPositions.clear();
+  fEnergies.clear();
+  fNumberOfClusters = 0;
+  fNumberOfNoisePoints = 0;
+}
+
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DamageClusterer::CellKey DamageClusterer::Key(const G4ThreeVector& p, G4int di, G4int dj,
+                                              G4int dk) const
+{
+  // 21 bits per axis; wrapped cells sharing a key are rejected by the
+  // distance test
+  auto index = [this](G4double value, G4int shift) {
+    return (CellKey)(((std::int64_t)std::floor(value / fEpsilon) + shift) & 0x1FFFFF);
+  };
+  return (index(p.x(), di) << 42) | (index(p.y(), dj) << 21) | index(p.z(), dk);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DamageClusterer::RegionQuery(std::size_t point, std::vector<std::size_t>& neighbours) const
+{
+  neighbours.clear();
+  const G4ThreeVector& p = fPositions[point];
+  G4double eps2 = fEpsilon * fEpsilon;
+
+  for (G4int i = -1; i <= 1; ++i) {
+    for (G4int j = -1; j <= 1; ++j) {
+      for (G4int k = -1; k <= 1; ++k) {
+        auto cell = fCells.find(Key(p, i, j, k));
+        if (cell == fCells.end()) continue;
+        for (std::size_t index : cell->second) {
+          if ((fPositions[index] - p).mag2() <= eps2) neighbours.push_back(index);
+        }
+      }
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DamageClusterer::EndOfEvent(G4int eventID)
+{
+  if (!fActive || fPositions.empty()) return;
+
+  // Cell list of the event
+  fCells.clear();
+  for (std::size_t i = 0; i < fPositions.size(); ++i) {
+    fCells[Key(fPositions[i])].push_back(i);
+  }
+
+  const G4int kUnvisited = -2;
+  const G4int kNoise = -1;
+  std::vector<G4int> labels(fPositions.size(), kUnvisited);
+
+  std::vector<std::size_t> neighbours;
+  std::vector<std::size_t> queue;
+  std::vector<std::size_t> members;
+  G4int nClusters = 0;
+
+  for (std::size_t i = 0; i < fPositions.size(); ++i) {
+    if (labels[i] != kUnvisited) continue;
+
+    RegionQuery(i, neighbours);
+    if ((G4int)neighbours.size() < fMinPoints) {
+      labels[i] = kNoise;
+      continue;
+    }
+
+    // Expand a new cluster from the core point i
+    G4int cluster = nClusters++;
+    labels[i] = cluster;
+    members.assign(1, i);
+    queue = neighbours;
+
+    while (!queue.empty()) {
+      std::size_t j = queue.back();
+      queue.pop_back();
+
+      if (labels[j] == kNoise) {
+        // Border point
+        labels[j] = cluster;
+        members.push_back(j);
+      }
+      if (labels[j] != kUnvisited) continue;
+
+      labels[j] = cluster;
+      members.push_back(j);
+
+      RegionQuery(j, neighbours);
+      if ((G4int)neighbours.size() >= fMinPoints) {
+        queue.insert(queue.end(), neighbours.begin(), neighbours.end());
+      }
+    }
+
+    WriteCluster(eventID, cluster, members);
+  }
+
+  fNumberOfClusters = nClusters;
+  for (G4int label : labels) {
+    if (label == kNoise) ++fNumberOfNoisePoints;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DamageClusterer::WriteCluster(G4int eventID, G4int clusterID,
+                                   const std::vector<std::size_t>& members)
+{
+  G4double energy = 0.;
+  G4ThreeVector centroid;
+  for (std::size_t index : members) {
+    energy += fEnergies[index];
+    centroid += fPositions[index] * fEnergies[index];
+  }
+  // Energy-weighted centroid
+  if (energy > 0.) centroid = centroid * (1. / energy);
+
+  G4int size = (G4int)members.size();
+  G4double values[4] = {energy / eV, centroid.x() / nm, centroid.y() / nm, centroid.z() / nm};
+
+  if (fColumnWriter != nullptr) {
+    fColumnWriter->Write(0, &eventID, 1);
+    fColumnWriter->Write(1, &clusterID, 1);
+    fColumnWriter->Write(2, &size, 1);
+    for (G4int column = 0; column < 4; ++column) {
+      fColumnWriter->Write(3 + column, &values[column], 1);
+    }
+    return;
+  }
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  analysisManager->FillNtupleIColumn(3, 0, eventID);
+  analysisManager->FillNtupleIColumn(3, 1, clusterID);
+  analysisManager->FillNtupleIColumn(3, 2, size);
+  for (G4int column = 0; column < 4; ++column) {
+    analysisManager->FillNtupleFColumn(3, 3 + column, (G4float)values[column]);
+  }
+  analysisManager->AddNtupleRow(3);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
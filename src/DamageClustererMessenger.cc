@@ -0,0 +1,116 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file DamageClustererMessenger.cc
+/// \brief Implementation of the DamageClustererMessenger class
+
+#include "DamageClustererMessenger.hh"
+#include "DamageClusterer.hh"
+
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIdirectory.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DamageClustererMessenger::DamageClustererMessenger(DamageClusterer* clusterer)
+  : fClusterer(clusterer)
+{
+  fClusterDir = new G4UIdirectory("/dna/cluster/");
+  fClusterDir->SetGuidance("clustering of the energy transfer points of each event");
+
+  fActiveCmd = new G4UIcmdWithABool("/dna/cluster/activate", this);
+  fActiveCmd->SetGuidance("Cluster the energy transfer points at the end of each event");
+  fActiveCmd->SetGuidance("and write one row per cluster to the cluster table.");
+  fActiveCmd->SetParameterName("activate", true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fEpsilonCmd = new G4UIcmdWithADoubleAndUnit("/dna/cluster/eps", this);
+  fEpsilonCmd->SetGuidance("Neighbourhood distance of the DBSCAN algorithm.");
+  fEpsilonCmd->SetParameterName("eps", false);
+  fEpsilonCmd->SetRange("eps>0.");
+  fEpsilonCmd->SetUnitCategory("Length");
+  fEpsilonCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fMinPointsCmd = new G4UIcmdWithAnInteger("/dna/cluster/minPts", this);
+  fMinPointsCmd->SetGuidance("Minimum number of points (itself included) within eps");
+  fMinPointsCmd->SetGuidance("of a core point.");
+  fMinPointsCmd->SetParameterName("minPts", false);
+  fMinPointsCmd->SetRange("minPts>0");
+  fMinPointsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fMinEnergyCmd = new G4UIcmdWithADoubleAndUnit("/dna/cluster/minEnergy", this);
+  fMinEnergyCmd->SetGuidance("Minimum energy deposit of a point to be clustered.");
+  fMinEnergyCmd->SetParameterName("minEnergy", false);
+  fMinEnergyCmd->SetRange("minEnergy>=0.");
+  fMinEnergyCmd->SetUnitCategory("Energy");
+  fMinEnergyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DamageClustererMessenger::~DamageClustererMessenger()
+{
+  delete fActiveCmd;
+  delete fEpsilonCmd;
+  delete fMinPointsCmd;
+  delete fMinEnergyCmd;
+  delete fClusterDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DamageClustererMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fActiveCmd) {
+    fClusterer->SetActive(fActiveCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fEpsilonCmd) {
+    fClusterer->SetEpsilon(fEpsilonCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fMinPointsCmd) {
+    fClusterer->SetMinPoints(fMinPointsCmd->GetNewIntValue(newValue));
+  }
+
+  if (command == fMinEnergyCmd) {
+    fClusterer->SetMinEnergy(fMinEnergyCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
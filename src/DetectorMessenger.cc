@@ -74,6 +74,24 @@ DetectorMessenger::DetectorMessenger(DetectorConstruction* Det, PhysicsList* PL)
   fpTrackingCutCmd->AvailableForStates(G4State_PreInit);
   fpTrackingCutCmd->SetToBeBroadcasted(false);
 
+  fpTableCacheCmd = new G4UIcmdWithAString("/dna/test/physicsTableCache", this);
+  fpTableCacheCmd->SetGuidance("Store the physics tables built by the first run in");
+  fpTableCacheCmd->SetGuidance("<directory>/<key> and retrieve them at the next starts;");
+  fpTableCacheCmd->SetGuidance("the key changes with the physics, cuts, EM parameters,");
+  fpTableCacheCmd->SetGuidance("materials and Geant4 version. none: off (default).");
+  fpTableCacheCmd->SetParameterName("directory", false);
+  fpTableCacheCmd->AvailableForStates(G4State_PreInit);
+  fpTableCacheCmd->SetToBeBroadcasted(false);
+
+  fpPhysicsScopeCmd = new G4UIcmdWithAString("/dna/test/physicsScope", this);
+  fpPhysicsScopeCmd->SetGuidance("Build the processes only for the particles reachable from");
+  fpPhysicsScopeCmd->SetGuidance("these primaries, with an optional maximum primary energy,");
+  fpPhysicsScopeCmd->SetGuidance("e.g. e- 10 keV, proton, alpha, ion; all: every particle");
+  fpPhysicsScopeCmd->SetGuidance("(default). Ions with raddecay, or other primaries: all.");
+  fpPhysicsScopeCmd->SetParameterName("primaries", false);
+  fpPhysicsScopeCmd->AvailableForStates(G4State_PreInit);
+  fpPhysicsScopeCmd->SetToBeBroadcasted(false);
+
   fDensityCmd = new G4UIcommand("/dna/test/setMatDens",this);
   fDensityCmd->SetGuidance("Set density of the target material");
   G4UIparameter* symbPrm = new G4UIparameter("name",'s',false);
@@ -107,6 +125,8 @@ DetectorMessenger::~DetectorMessenger()
   delete fpMaterCmd;
   delete fpPhysCmd;
   delete fpTrackingCutCmd;
+  delete fpTableCacheCmd;
+  delete fpPhysicsScopeCmd;
   delete fDensityCmd;
   delete fSizeCmd;
 }
@@ -122,6 +142,27 @@ void DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
   if (command == fpTrackingCutCmd)
     fpPhysList->SetTrackingCut(fpTrackingCutCmd->GetNewBoolValue(newValue));
 
+  if (command == fpTableCacheCmd) fpPhysList->SetTableCacheDirectory(newValue);
+
+  if (command == fpPhysicsScopeCmd) {
+    // Particle names, then the maximum energy and its unit
+    std::vector<G4String> primaries;
+    G4double maxEnergy = 0.;
+    std::istringstream is(newValue);
+    G4String token;
+    while (is >> token) {
+      std::istringstream number(token);
+      if (number >> maxEnergy) {
+        G4String unit = "MeV";
+        is >> unit;
+        maxEnergy *= G4UIcommand::ValueOf(unit);
+        break;
+      }
+      primaries.push_back(token);
+    }
+    fpPhysList->SetPhysicsScope(primaries, maxEnergy);
+  }
+
   if (command == fDensityCmd)
    {
      G4double dens;
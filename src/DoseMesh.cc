@@ -0,0 +1,185 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file DoseMesh.cc
+/// \brief Implementation of the DoseMesh class
+
+#include "DoseMesh.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DoseMesh::Configure(G4double worldSize, G4double voxelSize, G4bool sparse)
+{
+  fN = (G4long)std::ceil(worldSize / voxelSize);
+  fVoxelSize = voxelSize;
+  fHalfSize = fN * voxelSize / 2;
+  fInverseVoxelSize = 1. / voxelSize;
+  fSparse = sparse;
+
+  fSparseEnergy.clear();
+  fDenseEnergy.clear();
+  if (!fSparse) fDenseEnergy.assign(GetNumberOfVoxels(), 0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::size_t DoseMesh::GetNumberOfFilledVoxels() const
+{
+  if (fSparse) return fSparseEnergy.size();
+  return std::count_if(fDenseEnergy.begin(), fDenseEnergy.end(),
+                       [](G4double value) { return value > 0.; });
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DoseMesh::Merge(const DoseMesh& other)
+{
+  if (other.fN != fN || other.fSparse != fSparse) {
+    G4Exception("DoseMesh::Merge()", "dnaphysics005", FatalException,
+                "Meshes with different voxels cannot be merged.");
+    return;
+  }
+
+  if (fSparse) {
+    for (const auto& voxel : other.fSparseEnergy) {
+      fSparseEnergy[voxel.first] += voxel.second;
+    }
+    return;
+  }
+
+  for (std::size_t i = 0; i < fDenseEnergy.size(); ++i) {
+    fDenseEnergy[i] += other.fDenseEnergy[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DoseMesh::Write(const G4String& fileName, G4double density) const
+{
+  std::ofstream out(fileName, std::ios::binary);
+
+  // Dose = energy / (density * voxel volume)
+  G4double mass = density * fVoxelSize * fVoxelSize * fVoxelSize;
+  G4double toGray = 1. / mass / gray;
+
+  char header[64];
+  std::memset(header, 0, sizeof(header));
+  std::memcpy(header, "DNADOSE1", 8);
+  std::uint32_t sizes[4] = {fSparse ? 1u : 0u, (std::uint32_t)fN, (std::uint32_t)fN,
+                            (std::uint32_t)fN};
+  G4double values[2] = {fVoxelSize / nm, density / (g / cm3)};
+  std::uint64_t count = fSparse ? fSparseEnergy.size() : fDenseEnergy.size();
+  std::memcpy(header + 8, sizes, sizeof(sizes));
+  std::memcpy(header + 24, values, sizeof(values));
+  std::memcpy(header + 40, &count, sizeof(count));
+  out.write(header, sizeof(header));
+
+  if (!fSparse) {
+    std::vector<G4double> dose(fDenseEnergy.size());
+    for (std::size_t i = 0; i < dose.size(); ++i) {
+      dose[i] = fDenseEnergy[i] * toGray;
+    }
+    out.write((const char*)dose.data(), dose.size() * sizeof(G4double));
+    return;
+  }
+
+  std::vector<std::pair<std::uint64_t, G4double>> voxels(fSparseEnergy.begin(),
+                                                         fSparseEnergy.end());
+  std::sort(voxels.begin(), voxels.end());
+  for (const auto& voxel : voxels) {
+    G4double dose = voxel.second * toGray;
+    out.write((const char*)&voxel.first, sizeof(voxel.first));
+    out.write((const char*)&dose, sizeof(dose));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool DoseMesh::Read(const G4String& fileName, G4double& density)
+{
+  std::ifstream in(fileName, std::ios::binary);
+  char header[64];
+  if (!in.read(header, sizeof(header)) || std::memcmp(header, "DNADOSE1", 8) != 0) {
+    return false;
+  }
+
+  std::uint32_t sizes[4];
+  G4double values[2];
+  std::uint64_t count = 0;
+  std::memcpy(sizes, header + 8, sizeof(sizes));
+  std::memcpy(values, header + 24, sizeof(values));
+  std::memcpy(&count, header + 40, sizeof(count));
+
+  fN = sizes[1];
+  fVoxelSize = values[0] * nm;
+  fHalfSize = fN * fVoxelSize / 2;
+  fInverseVoxelSize = 1. / fVoxelSize;
+  fSparse = sizes[0] != 0;
+  density = values[1] * g / cm3;
+
+  // Energy = dose * density * voxel volume
+  G4double toEnergy = density * fVoxelSize * fVoxelSize * fVoxelSize * gray;
+
+  fSparseEnergy.clear();
+  fDenseEnergy.clear();
+  if (!fSparse) {
+    if (count != (std::uint64_t)GetNumberOfVoxels()) return false;
+    fDenseEnergy.resize(count);
+    if (!in.read((char*)fDenseEnergy.data(), count * sizeof(G4double))) return false;
+    for (auto& energy : fDenseEnergy) {
+      energy *= toEnergy;
+    }
+    return true;
+  }
+
+  for (std::uint64_t i = 0; i < count; ++i) {
+    std::uint64_t index = 0;
+    G4double dose = 0.;
+    if (!in.read((char*)&index, sizeof(index)) || !in.read((char*)&dose, sizeof(dose))) {
+      return false;
+    }
+    fSparseEnergy[index] = dose * toEnergy;
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
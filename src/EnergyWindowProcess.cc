@@ -0,0 +1,113 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file EnergyWindowProcess.cc
+/// \brief Implementation of the EnergyWindowProcess class
+
+#include "EnergyWindowProcess.hh"
+
+#include "G4ParticleChangeForGamma.hh"
+#include "G4Track.hh"
+#include "Randomize.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EnergyWindowProcess::EnergyWindowProcess(G4VProcess* process, const EnergyWindow* window,
+                                         const G4double* bias)
+  : G4WrapperProcess("", process->GetProcessType()), fWindow(window), fBias(bias)
+{
+  // RegisterProcess copies the name and type only: the sub-type orders the
+  // wrapper in G4PhysicsListHelper::RegisterProcess
+  RegisterProcess(process);
+  SetProcessSubType(process->GetProcessSubType());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double EnergyWindowProcess::PostStepGetPhysicalInteractionLength(const G4Track& track,
+                                                                  G4double previousStepSize,
+                                                                  G4ForceCondition* condition)
+{
+  G4double bias = GetCrossSectionFactor(track.GetKineticEnergy());
+  if (bias == 0.) {
+    *condition = NotForced;
+    return DBL_MAX;
+  }
+
+  // The number of interaction lengths left of the wrapped process decreases
+  // f times faster, hence a mean free path divided by f
+  G4double length = G4WrapperProcess::PostStepGetPhysicalInteractionLength(
+    track, previousStepSize * bias, condition);
+  return (length < DBL_MAX) ? length / bias : length;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VParticleChange* EnergyWindowProcess::PostStepDoIt(const G4Track& track, const G4Step& step)
+{
+  G4VParticleChange* change = G4WrapperProcess::PostStepDoIt(track, step);
+
+  G4double bias = *fBias;
+  fInteractionWeight = track.GetWeight() / bias;
+  fChangeRestored = false;
+  if (bias == 1.) return change;
+
+  change->SetSecondaryWeightByProcess(true);
+  for (G4int i = 0; i < change->GetNumberOfSecondaries(); ++i) {
+    change->GetSecondary(i)->SetWeight(fInteractionWeight);
+  }
+
+  // Russian roulette on the change of the primary
+  if (G4UniformRand() * bias < 1.) return change;
+
+  auto emChange = dynamic_cast<G4ParticleChangeForGamma*>(change);
+  if (emChange == nullptr) {
+    G4ExceptionDescription msg;
+    msg << "Cross section biasing of " << GetProcessName()
+        << " needs a G4ParticleChangeForGamma";
+    G4Exception("EnergyWindowProcess::PostStepDoIt()", "dnaphysics014", FatalException, msg);
+    return change;
+  }
+  fChangeRestored = true;
+  fInteractionKineticEnergy = emChange->GetProposedKineticEnergy();
+  fInteractionDirection = emChange->GetProposedMomentumDirection();
+
+  emChange->SetProposedKineticEnergy(track.GetKineticEnergy());
+  emChange->ProposeMomentumDirection(track.GetMomentumDirection());
+  emChange->ProposeTrackStatus(fAlive);
+  return change;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
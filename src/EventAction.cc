@@ -0,0 +1,111 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file EventAction.cc
+/// \brief Implementation of the EventAction class
+
+#include "EventAction.hh"
+
+#include "Run.hh"
+#include "RunAction.hh"
+#include "StepBuffer.hh"
+#include "SteppingAction.hh"
+
+#include "G4Event.hh"
+#include "G4RunManager.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EventAction::EventAction(RunAction* runAction, SteppingAction* steppingAction)
+  : fRunAction(runAction), fSteppingAction(steppingAction)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::BeginOfEventAction(const G4Event* event)
+{
+  fSteppingAction->ResetProfileTimer();
+
+  // Event ID in the cached runs of a configuration (see EventSeeder),
+  // -1 for the events skipped by a resumed run
+  G4int eventID = fRunAction->GetEventSeeder().GetGlobalEventID(event->GetEventID());
+  if (eventID < 0) return;
+
+  fRunAction->GetStepBuffer().SetEventID(eventID);
+  fRunAction->GetEventSampler().BeginOfEvent(eventID);
+  fRunAction->GetMicrodosimetryScorer().BeginOfEvent();
+  fRunAction->GetDamageClusterer().BeginOfEvent();
+  fRunAction->GetRadialDoseScorer().BeginOfEvent();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventAction::EndOfEventAction(const G4Event* event)
+{
+  auto run = static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+  G4int eventID = fRunAction->GetEventSeeder().GetGlobalEventID(event->GetEventID());
+  if (eventID < 0) {
+    run->StopEventTimer();
+    return;
+  }
+
+  // Write the steps recorded during this event, or keep them in the
+  // reservoir of sampled events
+  fRunAction->GetEventSampler().EndOfEvent(fRunAction->GetStepBuffer());
+
+  // Score the energy deposits of this event in the microdosimetric sites
+  MicrodosimetryScorer& scorer = fRunAction->GetMicrodosimetryScorer();
+  if (scorer.IsActive()) {
+    scorer.EndOfEvent(run->GetLinealEnergySpectrum());
+  }
+
+  // Cluster the energy transfer points of this event
+  DamageClusterer& clusterer = fRunAction->GetDamageClusterer();
+  if (clusterer.IsActive()) {
+    clusterer.EndOfEvent(eventID);
+    run->AddClusters(clusterer.GetNumberOfClusters(), clusterer.GetNumberOfNoisePoints());
+  }
+
+  // Bin the secondary deposits by distance to the primary path
+  RadialDoseScorer& radial = fRunAction->GetRadialDoseScorer();
+  if (radial.IsActive()) {
+    radial.EndOfEvent(run->GetRadialDoseProfile());
+  }
+
+  // Rows of the completed events, every /dna/checkpoint/interval events
+  if (fRunAction->GetCheckpoint().EndOfEvent(eventID)) fRunAction->WriteCheckpoint();
+
+  run->StopEventTimer();
+}
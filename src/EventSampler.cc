@@ -0,0 +1,156 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file EventSampler.cc
+/// \brief Implementation of the EventSampler class
+
+#include "EventSampler.hh"
+
+#include <algorithm>
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventSampler::SetMode(const G4String& mode, G4double value)
+{
+  if (mode == "every") {
+    fMode = kSampleEvery;
+    fValue = std::max(1., std::floor(value));
+  }
+  else if (mode == "reservoir") {
+    fMode = kSampleReservoir;
+    fValue = std::max(1., std::floor(value));
+  }
+  else if (mode == "steps") {
+    fMode = kSampleSteps;
+    fValue = std::min(std::max(value, 0.), 1.);
+  }
+  else {
+    fMode = kSampleAll;
+    fValue = 1.;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String EventSampler::GetModeName() const
+{
+  switch (fMode) {
+    case kSampleEvery:
+      return "every";
+    case kSampleReservoir:
+      return "reservoir";
+    case kSampleSteps:
+      return "steps";
+    default:
+      return "all";
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventSampler::BeginOfRun()
+{
+  fEventsSeen = 0;
+  fEventsRecorded = 0;
+  fRecordEvent = true;
+  fSlots.clear();
+  fTracks.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventSampler::BeginOfEvent(G4int eventID)
+{
+  fEventID = eventID;
+
+  // Independent stream for each event
+  fState = fSeed ^ ((std::uint64_t)eventID * 0xd1b54a32d192ed03ULL);
+
+  fRecordEvent = (fMode != kSampleEvery) || (eventID % (G4int)fValue == 0);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventSampler::EndOfEvent(StepBuffer& buffer)
+{
+  ++fEventsSeen;
+
+  if (fMode != kSampleReservoir) {
+    if (fRecordEvent) ++fEventsRecorded;
+    buffer.Flush();
+    return;
+  }
+
+  // Reservoir sampling: the n-th event replaces a random slot with
+  // probability K/n, so that every event is kept with the same probability
+  std::size_t size = (std::size_t)fValue;
+  std::size_t slot = fSlots.size();
+  if (fSlots.size() < size) {
+    fSlots.emplace_back();
+    fEventsRecorded = (G4int)fSlots.size();
+  }
+  else {
+    slot = (std::size_t)(Uniform() * fEventsSeen);
+  }
+
+  if (slot < size) {
+    fSlots[slot].eventID = fEventID;
+    buffer.SwapRows(fSlots[slot].steps);
+    fSlots[slot].tracks.swap(fTracks);
+  }
+  buffer.Clear();
+  fTracks.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EventSampler::SortHeldEvents()
+{
+  std::sort(fSlots.begin(), fSlots.end(),
+            [](const Slot& a, const Slot& b) { return a.eventID < b.eventID; });
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double EventSampler::GetSamplingFactor() const
+{
+  // Fraction of the events (or steps) of this thread that were recorded
+  if (fMode == kSampleSteps) return fValue;
+  if (fEventsSeen == 0) return 1.;
+  return (G4double)fEventsRecorded / fEventsSeen;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
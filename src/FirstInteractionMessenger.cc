@@ -0,0 +1,103 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file FirstInteractionMessenger.cc
+/// \brief Implementation of the FirstInteractionMessenger class
+
+#include "FirstInteractionMessenger.hh"
+#include "FirstInteractionSampler.hh"
+
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIdirectory.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+FirstInteractionMessenger::FirstInteractionMessenger(FirstInteractionSampler* sampler)
+  : fSampler(sampler)
+{
+  fDirectDir = new G4UIdirectory("/dna/direct/");
+  fDirectDir->SetGuidance("direct sampling of the first interaction of the primary");
+
+  fActiveCmd = new G4UIcmdWithABool("/dna/direct/activate", this);
+  fActiveCmd->SetGuidance("Sample the first interaction of the primaries directly,");
+  fActiveCmd->SetGuidance("in the world material, instead of tracking them.");
+  fActiveCmd->SetParameterName("activate", true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSamplesCmd = new G4UIcmdWithAnInteger("/dna/direct/samplesPerEvent", this);
+  fSamplesCmd->SetGuidance("Number of first interactions sampled per event (default 1000).");
+  fSamplesCmd->SetParameterName("samples", false);
+  fSamplesCmd->SetRange("samples>0");
+  fSamplesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fForceCmd = new G4UIcmdWithABool("/dna/direct/forceInWorld", this);
+  fForceCmd->SetGuidance("Force the first interaction inside the world volume, with the");
+  fForceCmd->SetGuidance("weight 1 - exp(-Sigma L) (weight column of the step ntuple),");
+  fForceCmd->SetGuidance("instead of sampling it in the world material taken as infinite.");
+  fForceCmd->SetParameterName("force", true);
+  fForceCmd->SetDefaultValue(true);
+  fForceCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+FirstInteractionMessenger::~FirstInteractionMessenger()
+{
+  delete fActiveCmd;
+  delete fSamplesCmd;
+  delete fForceCmd;
+  delete fDirectDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void FirstInteractionMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fActiveCmd) {
+    fSampler->SetActive(fActiveCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fSamplesCmd) {
+    fSampler->SetSamplesPerEvent(fSamplesCmd->GetNewIntValue(newValue));
+  }
+
+  if (command == fForceCmd) {
+    fSampler->SetForceInWorld(fForceCmd->GetNewBoolValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
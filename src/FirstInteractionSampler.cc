@@ -0,0 +1,280 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file FirstInteractionSampler.cc
+/// \brief Implementation of the FirstInteractionSampler class
+
+#include "FirstInteractionSampler.hh"
+#include "FirstInteractionMessenger.hh"
+
+#include "EnergyWindowProcess.hh"
+#include "Run.hh"
+#include "RunAction.hh"
+
+#include "G4DynamicParticle.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Navigator.hh"
+#include "G4ParticleGun.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4TransportationManager.hh"
+#include "G4VEmProcess.hh"
+#include "G4VParticleChange.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VProcess.hh"
+#include "G4VSolid.hh"
+#include "Randomize.hh"
+
+#include <cfloat>
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+FirstInteractionSampler::FirstInteractionSampler()
+{
+  fMessenger = new FirstInteractionMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+FirstInteractionSampler::~FirstInteractionSampler()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void FirstInteractionSampler::SetParticle(const G4ParticleDefinition* particle)
+{
+  // The activation of the processes can change between runs
+  // (/process/inactivate), so the list is rebuilt for each event
+  G4bool changed = (particle != fParticle);
+  fParticle = particle;
+  fProcesses.clear();
+
+  G4ProcessManager* manager = particle->GetProcessManager();
+  G4ProcessVector* processes = manager->GetPostStepProcessVector(typeDoIt);
+  for (G4int i = 0; i < (G4int)processes->size(); ++i) {
+    G4VProcess* process = (*processes)[i];
+    if (process->GetProcessType() == fTransportation) continue;
+    if (!manager->GetProcessActivation(process)) continue;
+    fProcesses.push_back(process);
+  }
+
+  if (fProcesses.empty() && changed) {
+    G4ExceptionDescription description;
+    description << "No active discrete process for " << particle->GetParticleName()
+                << "; no first interaction is sampled.";
+    G4Exception("FirstInteractionSampler::SetParticle()", "dnaphysics007", JustWarning,
+                description);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int FirstInteractionSampler::Sample(const G4ParticleGun& gun, G4int eventID,
+                                      RunAction& runAction)
+{
+  const G4ParticleDefinition* particle = gun.GetParticleDefinition();
+  SetParticle(particle);
+  if (fProcesses.empty()) return 0;
+
+  // Infinite medium made of the world material
+  G4LogicalVolume* world = G4TransportationManager::GetTransportationManager()
+                             ->GetNavigatorForTracking()
+                             ->GetWorldVolume()
+                             ->GetLogicalVolume();
+  G4Material* material = world->GetMaterial();
+  const G4MaterialCutsCouple* couple = world->GetMaterialCutsCouple();
+
+  const G4ThreeVector& position = gun.GetParticlePosition();
+  const G4ThreeVector& direction = gun.GetParticleMomentumDirection();
+  const G4double energy = gun.GetParticleEnergy();
+
+  // Forced collision: distance to the world boundary along the gun direction
+  G4double worldDistance = DBL_MAX;
+  if (fForceInWorld) worldDistance = world->GetSolid()->DistanceToOut(position, direction);
+
+  // With the /dna/mi/bias factors the closest interaction would follow the
+  // enhanced cross sections: the interaction is then sampled as a forced
+  // collision, in the infinite medium unless forced in the world, whose
+  // weight restores the analog distance and process probabilities
+  G4bool biased = false;
+  for (G4VProcess* process : fProcesses) {
+    auto windowProcess = dynamic_cast<const EnergyWindowProcess*>(process);
+    if (windowProcess != nullptr && windowProcess->GetCrossSectionFactor(energy) > 1.) {
+      biased = true;
+    }
+  }
+
+  // The EventAction of this event is called after the primary generation
+  StepBuffer& buffer = runAction.GetStepBuffer();
+  EventSampler& sampler = runAction.GetEventSampler();
+  const StepFilter& filter = runAction.GetStepFilter();
+  StepClassifier& classifier = runAction.GetStepClassifier();
+  buffer.SetEventID(eventID);
+  sampler.BeginOfEvent(eventID);
+
+  G4int flagParticle = classifier.ParticleFlag(particle);
+
+  G4Step step;
+  G4StepPoint* preStep = step.GetPreStepPoint();
+  G4StepPoint* postStep = step.GetPostStepPoint();
+
+  for (G4int n = 0; n < fSamplesPerEvent; ++n) {
+    G4Track track(new G4DynamicParticle(particle, direction, energy), 0., position);
+    track.SetTrackID(1);
+    track.SetParentID(0);
+    track.SetStep(&step);
+    track.IncrementCurrentStepNumber();
+
+    step.SetTrack(&track);
+    step.ResetTotalEnergyDeposit();
+    preStep->SetPosition(position);
+    preStep->SetMomentumDirection(direction);
+    preStep->SetKineticEnergy(energy);
+    preStep->SetMaterial(material);
+    preStep->SetMaterialCutsCouple(couple);
+
+    // Closest interaction among the active processes (only prepared for
+    // their PostStepDoIt with the forced collision)
+    G4VProcess* selected = nullptr;
+    G4double length = DBL_MAX;
+    for (G4VProcess* process : fProcesses) {
+      process->StartTracking(&track);
+      G4ForceCondition condition = NotForced;
+      G4double processLength = process->PostStepGPIL(track, 0., &condition);
+      if (processLength < length) {
+        length = processLength;
+        selected = process;
+      }
+    }
+
+    G4double forcedWeight = 1.;
+    if (fForceInWorld || biased) {
+      selected = ForceInteraction(energy, couple, worldDistance, length, forcedWeight);
+    }
+    if (selected == nullptr) continue;
+    track.SetWeight(forcedWeight);
+
+    *postStep = *preStep;
+    postStep->SetPosition(position + length * direction);
+    postStep->SetProcessDefinedStep(selected);
+    step.SetStepLength(length);
+    track.SetPosition(postStep->GetPosition());
+    track.SetStepLength(length);
+
+    G4VParticleChange* change = selected->PostStepDoIt(track, step);
+    change->UpdateStepForPostStep(&step);
+
+    // Only the primary step is recorded
+    for (G4int i = 0; i < change->GetNumberOfSecondaries(); ++i) {
+      delete change->GetSecondary(i);
+    }
+    change->Clear();
+
+    for (G4VProcess* process : fProcesses) {
+      process->EndTracking();
+    }
+
+    G4int flagProcess = classifier.ProcessFlag(flagParticle, selected);
+    G4double weight = StepClassifier::StepWeight(&step, flagProcess);
+    G4int multiplicity = StepClassifier::Multiplicity(flagProcess);
+    if (multiplicity > 0) runAction.GetRun()->AddMultipleIonisation(multiplicity, weight);
+
+    if (filter.IsActive()
+        && !filter.Accept(flagParticle, flagProcess, energy, postStep->GetPosition()))
+      continue;
+    if (!sampler.KeepStep()) continue;
+
+    buffer.Add(&step, flagParticle, flagProcess, weight);
+  }
+
+  return fSamplesPerEvent;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VProcess* FirstInteractionSampler::ForceInteraction(G4double energy,
+                                                      const G4MaterialCutsCouple* couple,
+                                                      G4double worldDistance, G4double& length,
+                                                      G4double& weight)
+{
+  // Total macroscopic cross section, analog and with the biasing factors
+  // of the multiple ionisation processes (see EnergyWindowProcess)
+  G4double sigma = 0.;
+  G4double biasedSigma = 0.;
+  fCrossSections.assign(fProcesses.size(), 0.);
+  for (std::size_t i = 0; i < fProcesses.size(); ++i) {
+    G4VProcess* process = fProcesses[i];
+    G4double factor = 1.;
+    auto windowProcess = dynamic_cast<EnergyWindowProcess*>(process);
+    if (windowProcess != nullptr) {
+      factor = windowProcess->GetCrossSectionFactor(energy);
+      process = windowProcess->GetWrappedProcess();
+    }
+    // Discrete processes without cross section (e.g. capture) never interact
+    auto emProcess = dynamic_cast<G4VEmProcess*>(process);
+    if (emProcess == nullptr || factor == 0.) continue;
+
+    G4double crossSection = emProcess->CrossSectionPerVolume(energy, couple);
+    sigma += crossSection;
+    fCrossSections[i] = factor * crossSection;
+    biasedSigma += fCrossSections[i];
+  }
+  if (sigma <= 0. || worldDistance <= 0.) return nullptr;
+
+  // Distance of the first interaction, given that it happens in the world
+  // (probability 1 in the infinite medium)
+  G4double probability = (worldDistance < DBL_MAX) ? -std::expm1(-sigma * worldDistance) : 1.;
+  length = -std::log1p(-G4UniformRand() * probability) / sigma;
+
+  // The biased processes divide the weight by their factor
+  weight = probability * biasedSigma / sigma;
+
+  G4double r = G4UniformRand() * biasedSigma;
+  std::size_t last = 0;
+  for (std::size_t i = 0; i < fProcesses.size(); ++i) {
+    if (fCrossSections[i] <= 0.) continue;
+    last = i;
+    r -= fCrossSections[i];
+    if (r < 0.) break;
+  }
+  return fProcesses[last];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
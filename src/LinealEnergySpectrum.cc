@@ -0,0 +1,130 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file LinealEnergySpectrum.cc
+/// \brief Implementation of the LinealEnergySpectrum class
+
+#include "LinealEnergySpectrum.hh"
+
+#include <cmath>
+#include <fstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void LinealEnergySpectrum::SetBinning(G4double yMin, G4double yMax, G4int binsPerDecade)
+{
+  fLogYMin = std::log10(yMin);
+  fBinsPerDecade = binsPerDecade;
+  G4int nBins = (G4int)std::ceil((std::log10(yMax) - fLogYMin) * binsPerDecade);
+  fWeights.assign(nBins, 0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void LinealEnergySpectrum::Fill(G4double y, G4double weight)
+{
+  if (y <= 0.) return;
+
+  // The means include the values outside of the binning
+  fSumW += weight;
+  fSumWY += weight * y;
+  fSumWY2 += weight * y * y;
+
+  G4int bin = (G4int)std::floor((std::log10(y) - fLogYMin) * fBinsPerDecade);
+  if (bin < 0 || bin >= (G4int)fWeights.size()) {
+    fOutOfRange += weight;
+    return;
+  }
+  fWeights[bin] += weight;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void LinealEnergySpectrum::Merge(const LinealEnergySpectrum& other)
+{
+  if (fWeights.size() != other.fWeights.size()) {
+    G4Exception("LinealEnergySpectrum::Merge()", "dnaphysics004", FatalException,
+                "Spectra with different binnings cannot be merged.");
+    return;
+  }
+  for (std::size_t i = 0; i < fWeights.size(); ++i) {
+    fWeights[i] += other.fWeights[i];
+  }
+  fSumW += other.fSumW;
+  fSumWY += other.fSumWY;
+  fSumWY2 += other.fSumWY2;
+  fOutOfRange += other.fOutOfRange;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double LinealEnergySpectrum::GetFrequencyMean() const
+{
+  return fSumW > 0. ? fSumWY / fSumW : 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double LinealEnergySpectrum::GetDoseMean() const
+{
+  return fSumWY > 0. ? fSumWY2 / fSumWY : 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void LinealEnergySpectrum::Write(const G4String& fileName, const G4String& description) const
+{
+  std::ofstream out(fileName);
+  out << "# " << description << '\n';
+  out << "# sum of weights " << fSumW << ", out of range " << fOutOfRange << '\n';
+  out << "# yF " << GetFrequencyMean() << " keV/um, yD " << GetDoseMean() << " keV/um" << '\n';
+  out << "# yLow(keV/um) yHigh(keV/um) f(y) d(y) y*f(y) y*d(y)" << '\n';
+
+  G4double yF = GetFrequencyMean();
+
+  for (std::size_t i = 0; i < fWeights.size(); ++i) {
+    G4double yLow = std::pow(10., fLogYMin + i / fBinsPerDecade);
+    G4double yHigh = std::pow(10., fLogYMin + (i + 1) / fBinsPerDecade);
+    G4double y = std::sqrt(yLow * yHigh);
+
+    // d(y) = y f(y) / yF
+    G4double f = fSumW > 0. ? fWeights[i] / (fSumW * (yHigh - yLow)) : 0.;
+    G4double d = yF > 0. ? y * f / yF : 0.;
+
+    out << yLow << ' ' << yHigh << ' ' << f << ' ' << d << ' ' << y * f << ' ' << y * d << '\n';
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
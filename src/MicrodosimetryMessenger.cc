@@ -0,0 +1,150 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file MicrodosimetryMessenger.cc
+/// \brief Implementation of the MicrodosimetryMessenger class
+
+#include "MicrodosimetryMessenger.hh"
+#include "MicrodosimetryScorer.hh"
+
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIdirectory.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MicrodosimetryMessenger::MicrodosimetryMessenger(MicrodosimetryScorer* scorer)
+  : fScorer(scorer)
+{
+  fMicroDir = new G4UIdirectory("/dna/micro/");
+  fMicroDir->SetGuidance("online lineal energy scorer");
+
+  fActiveCmd = new G4UIcmdWithABool("/dna/micro/activate", this);
+  fActiveCmd->SetGuidance("Score the lineal energy spectrum (written to dna.lineal).");
+  fActiveCmd->SetParameterName("activate", true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fShapeCmd = new G4UIcmdWithAString("/dna/micro/shape", this);
+  fShapeCmd->SetGuidance("Shape of the sites (cylinder axis along z).");
+  fShapeCmd->SetParameterName("shape", false);
+  fShapeCmd->SetCandidates("sphere cylinder");
+  fShapeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fDiameterCmd = new G4UIcmdWithADoubleAndUnit("/dna/micro/diameter", this);
+  fDiameterCmd->SetGuidance("Diameter of the sites.");
+  fDiameterCmd->SetParameterName("diameter", false);
+  fDiameterCmd->SetRange("diameter>0.");
+  fDiameterCmd->SetUnitCategory("Length");
+  fDiameterCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fHeightCmd = new G4UIcmdWithADoubleAndUnit("/dna/micro/height", this);
+  fHeightCmd->SetGuidance("Height of the cylindrical sites.");
+  fHeightCmd->SetParameterName("height", false);
+  fHeightCmd->SetRange("height>0.");
+  fHeightCmd->SetUnitCategory("Length");
+  fHeightCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fPlacementCmd = new G4UIcmdWithAString("/dna/micro/placement", this);
+  fPlacementCmd->SetGuidance("Placement of the sites:");
+  fPlacementCmd->SetGuidance(" tiled: randomly shifted lattice of sites");
+  fPlacementCmd->SetGuidance(" random: sites placed around random energy deposits");
+  fPlacementCmd->SetParameterName("placement", false);
+  fPlacementCmd->SetCandidates("tiled random");
+  fPlacementCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSitesCmd = new G4UIcmdWithAnInteger("/dna/micro/sitesPerEvent", this);
+  fSitesCmd->SetGuidance("Number of random sites per event.");
+  fSitesCmd->SetParameterName("sites", false);
+  fSitesCmd->SetRange("sites>0");
+  fSitesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBinsCmd = new G4UIcmdWithAnInteger("/dna/micro/binsPerDecade", this);
+  fBinsCmd->SetGuidance("Number of logarithmic y bins per decade (0.01 to 10^4 keV/um).");
+  fBinsCmd->SetParameterName("bins", false);
+  fBinsCmd->SetRange("bins>0");
+  fBinsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MicrodosimetryMessenger::~MicrodosimetryMessenger()
+{
+  delete fActiveCmd;
+  delete fShapeCmd;
+  delete fDiameterCmd;
+  delete fHeightCmd;
+  delete fPlacementCmd;
+  delete fSitesCmd;
+  delete fBinsCmd;
+  delete fMicroDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MicrodosimetryMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fActiveCmd) {
+    fScorer->SetActive(fActiveCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fShapeCmd) {
+    fScorer->SetCylinder(newValue == "cylinder");
+  }
+
+  if (command == fDiameterCmd) {
+    fScorer->SetDiameter(fDiameterCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fHeightCmd) {
+    fScorer->SetHeight(fHeightCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fPlacementCmd) {
+    fScorer->SetRandomPlacement(newValue == "random");
+  }
+
+  if (command == fSitesCmd) {
+    fScorer->SetNumberOfSites(fSitesCmd->GetNewIntValue(newValue));
+  }
+
+  if (command == fBinsCmd) {
+    fScorer->SetBinsPerDecade(fBinsCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
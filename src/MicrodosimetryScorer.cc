@@ -0,0 +1,236 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file MicrodosimetryScorer.cc
+/// \brief Implementation of the MicrodosimetryScorer class
+
+#include "MicrodosimetryScorer.hh"
+
+#include "LinealEnergySpectrum.hh"
+#include "MicrodosimetryMessenger.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MicrodosimetryScorer::MicrodosimetryScorer() : fDiameter(10 * nm), fHeight(10 * nm)
+{
+  fMessenger = new MicrodosimetryMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MicrodosimetryScorer::~MicrodosimetryScorer()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double MicrodosimetryScorer::GetMeanChordLength() const
+{
+  // Cauchy: 4 V / S, i.e. 2d/3 for a sphere and 2dh / (2h + d) for a cylinder
+  if (fCylinder) return 2 * fDiameter * fHeight / (2 * fHeight + fDiameter);
+  return 2 * fDiameter / 3;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String MicrodosimetryScorer::GetDescription() const
+{
+  std::ostringstream description;
+  description << (fCylinder ? "cylinder" : "sphere") << " sites, diameter " << fDiameter / nm
+              << " nm";
+  if (fCylinder) description << ", height " << fHeight / nm << " nm";
+  description << ", mean chord " << GetMeanChordLength() / nm << " nm, ";
+  if (fRandomPlacement) {
+    description << "random placement (" << fNumberOfSites << " sites/event)";
+  }
+  else {
+    description << "tiled placement";
+  }
+  return description.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MicrodosimetryScorer::BeginOfEvent()
+{
+  fPositions.clear();
+  fEnergies.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MicrodosimetryScorer::CellKey MicrodosimetryScorer::Key(G4double x, G4double y, G4double z) const
+{
+  // 21 bits per axis, wrapped: distinct cells sharing a key only cost extra
+  // Contains() tests
+  auto index = [](G4double value, G4double size, G4double origin) {
+    return (CellKey)((std::int64_t)std::floor((value - origin) / size) & 0x1FFFFF);
+  };
+  return (index(x, fCellSize.x(), fOrigin.x()) << 42)
+         | (index(y, fCellSize.y(), fOrigin.y()) << 21) | index(z, fCellSize.z(), fOrigin.z());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool MicrodosimetryScorer::Contains(const G4ThreeVector& center,
+                                      const G4ThreeVector& point) const
+{
+  G4ThreeVector d = point - center;
+  G4double r = fDiameter / 2;
+  if (fCylinder) {
+    return d.x() * d.x() + d.y() * d.y() <= r * r && std::abs(d.z()) <= fHeight / 2;
+  }
+  return d.mag2() <= r * r;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreeVector MicrodosimetryScorer::SampleInSite() const
+{
+  // Uniform point in a site centred on the origin
+  G4double r = fDiameter / 2;
+  G4double halfHeight = fCylinder ? fHeight / 2 : r;
+  G4ThreeVector point;
+  do {
+    point.set((2 * G4UniformRand() - 1) * r, (2 * G4UniformRand() - 1) * r,
+              (2 * G4UniformRand() - 1) * halfHeight);
+  } while (!Contains(G4ThreeVector(), point));
+  return point;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MicrodosimetryScorer::BuildIndex()
+{
+  fCells.clear();
+  for (std::size_t i = 0; i < fPositions.size(); ++i) {
+    const G4ThreeVector& p = fPositions[i];
+    fCells[Key(p.x(), p.y(), p.z())].push_back(i);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MicrodosimetryScorer::EndOfEvent(LinealEnergySpectrum& spectrum)
+{
+  if (!fActive || fPositions.empty()) return;
+
+  // Cells have the size of the bounding box of a site
+  G4double height = fCylinder ? fHeight : fDiameter;
+  fCellSize.set(fDiameter, fDiameter, height);
+
+  if (fRandomPlacement) {
+    ScoreRandom(spectrum);
+  }
+  else {
+    ScoreTiled(spectrum);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MicrodosimetryScorer::ScoreTiled(LinealEnergySpectrum& spectrum)
+{
+  // The lattice is shifted randomly for each event
+  fOrigin.set(G4UniformRand() * fCellSize.x(), G4UniformRand() * fCellSize.y(),
+              G4UniformRand() * fCellSize.z());
+
+  std::unordered_map<CellKey, G4double> imparted;
+
+  for (std::size_t i = 0; i < fPositions.size(); ++i) {
+    const G4ThreeVector& p = fPositions[i];
+    G4ThreeVector center(
+      fOrigin.x() + (std::floor((p.x() - fOrigin.x()) / fCellSize.x()) + 0.5) * fCellSize.x(),
+      fOrigin.y() + (std::floor((p.y() - fOrigin.y()) / fCellSize.y()) + 0.5) * fCellSize.y(),
+      fOrigin.z() + (std::floor((p.z() - fOrigin.z()) / fCellSize.z()) + 0.5) * fCellSize.z());
+    if (!Contains(center, p)) continue;
+    imparted[Key(p.x(), p.y(), p.z())] += fEnergies[i];
+  }
+
+  G4double meanChord = GetMeanChordLength();
+  for (const auto& site : imparted) {
+    spectrum.Fill(site.second / meanChord / (keV / um), 1.);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MicrodosimetryScorer::ScoreRandom(LinealEnergySpectrum& spectrum)
+{
+  fOrigin.set(0., 0., 0.);
+  BuildIndex();
+
+  G4double meanChord = GetMeanChordLength();
+  std::size_t nDeposits = fPositions.size();
+
+  for (G4int site = 0; site < fNumberOfSites; ++site) {
+    std::size_t seed = std::min((std::size_t)(G4UniformRand() * nDeposits), nDeposits - 1);
+    G4ThreeVector center = fPositions[seed] + SampleInSite();
+
+    // A site overlaps at most the 3x3x3 cells around its centre
+    G4double imparted = 0.;
+    G4int inside = 0;
+    for (G4int i = -1; i <= 1; ++i) {
+      for (G4int j = -1; j <= 1; ++j) {
+        for (G4int k = -1; k <= 1; ++k) {
+          auto cell = fCells.find(Key(center.x() + i * fCellSize.x(),
+                                      center.y() + j * fCellSize.y(),
+                                      center.z() + k * fCellSize.z()));
+          if (cell == fCells.end()) continue;
+          for (std::size_t index : cell->second) {
+            if (!Contains(center, fPositions[index])) continue;
+            imparted += fEnergies[index];
+            ++inside;
+          }
+        }
+      }
+    }
+
+    // A site is drawn with a probability proportional to the number of
+    // deposits it contains (the seed is always inside, so inside >= 1)
+    G4double weight = (G4double)nDeposits / (fNumberOfSites * inside);
+    spectrum.Fill(imparted / meanChord / (keV / um), weight);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
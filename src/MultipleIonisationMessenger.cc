@@ -0,0 +1,185 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file MultipleIonisationMessenger.cc
+/// \brief Implementation of the MultipleIonisationMessenger class
+
+#include "MultipleIonisationMessenger.hh"
+#include "PhysicsList.hh"
+
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MultipleIonisationMessenger::MultipleIonisationMessenger(PhysicsList* physicsList)
+  : fPhysicsList(physicsList)
+{
+  fMIDir = new G4UIdirectory("/dna/mi/");
+  fMIDir->SetGuidance("double, triple and quadruple ionisation processes");
+
+  fEnableCmd = new G4UIcommand("/dna/mi/enable", this);
+  fEnableCmd->SetGuidance("Register (or not) the multiple ionisation processes of a particle");
+  fEnableCmd->SetGuidance("(proton, alpha, GenericIon, hydrogen or all) and multiplicity");
+  fEnableCmd->SetGuidance("(2, 3, 4 or all). All but hydrogen are registered by default.");
+  auto particlePrm = new G4UIparameter("particle", 's', false);
+  particlePrm->SetParameterCandidates("proton alpha GenericIon ion hydrogen all");
+  fEnableCmd->SetParameter(particlePrm);
+  auto multiplicityPrm = new G4UIparameter("multiplicity", 's', false);
+  multiplicityPrm->SetParameterCandidates("2 3 4 all");
+  fEnableCmd->SetParameter(multiplicityPrm);
+  auto enablePrm = new G4UIparameter("enable", 'b', false);
+  fEnableCmd->SetParameter(enablePrm);
+  fEnableCmd->AvailableForStates(G4State_PreInit);
+  fEnableCmd->SetToBeBroadcasted(false);
+
+  fWindowCmd = new G4UIcommand("/dna/mi/energyWindow", this);
+  fWindowCmd->SetGuidance("Kinetic energy window [min, max) of the multiple ionisation");
+  fWindowCmd->SetGuidance("processes of a particle and multiplicity: outside of it their");
+  fWindowCmd->SetGuidance("cross section is not computed (default: all energies).");
+  auto windowParticlePrm = new G4UIparameter("particle", 's', false);
+  windowParticlePrm->SetParameterCandidates("proton alpha GenericIon ion hydrogen all");
+  fWindowCmd->SetParameter(windowParticlePrm);
+  auto windowMultiplicityPrm = new G4UIparameter("multiplicity", 's', false);
+  windowMultiplicityPrm->SetParameterCandidates("2 3 4 all");
+  fWindowCmd->SetParameter(windowMultiplicityPrm);
+  auto minPrm = new G4UIparameter("min", 'd', false);
+  minPrm->SetParameterRange("min>=0.");
+  fWindowCmd->SetParameter(minPrm);
+  auto maxPrm = new G4UIparameter("max", 'd', false);
+  maxPrm->SetParameterRange("max>0.");
+  fWindowCmd->SetParameter(maxPrm);
+  auto unitPrm = new G4UIparameter("unit", 's', true);
+  unitPrm->SetDefaultUnit("MeV");
+  fWindowCmd->SetParameter(unitPrm);
+  fWindowCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fWindowCmd->SetToBeBroadcasted(false);
+
+  fBiasCmd = new G4UIcommand("/dna/mi/bias", this);
+  fBiasCmd->SetGuidance("Enhance the cross section of the multiple ionisation processes of a");
+  fBiasCmd->SetGuidance("particle and multiplicity by a factor f: their interactions, energy");
+  fBiasCmd->SetGuidance("deposits and secondaries get the weight 1/f (weight column of the");
+  fBiasCmd->SetGuidance("step ntuple), the change of the primary is kept with probability 1/f.");
+  auto biasParticlePrm = new G4UIparameter("particle", 's', false);
+  biasParticlePrm->SetParameterCandidates("proton alpha GenericIon ion hydrogen all");
+  fBiasCmd->SetParameter(biasParticlePrm);
+  auto biasMultiplicityPrm = new G4UIparameter("multiplicity", 's', false);
+  biasMultiplicityPrm->SetParameterCandidates("2 3 4 all");
+  fBiasCmd->SetParameter(biasMultiplicityPrm);
+  auto factorPrm = new G4UIparameter("factor", 'd', false);
+  factorPrm->SetParameterRange("factor>=1.");
+  fBiasCmd->SetParameter(factorPrm);
+  fBiasCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fBiasCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MultipleIonisationMessenger::~MultipleIonisationMessenger()
+{
+  delete fEnableCmd;
+  delete fWindowCmd;
+  delete fBiasCmd;
+  delete fMIDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool MultipleIonisationMessenger::Select(const G4String& particle,
+                                           const G4String& multiplicity,
+                                           std::vector<G4int>& particles,
+                                           std::vector<G4int>& multiplicities) const
+{
+  for (G4int i = 0; i < PhysicsList::kNMIParticles; ++i) {
+    if (particle == "all" || PhysicsList::GetMIParticleIndex(particle) == i) {
+      particles.push_back(i);
+    }
+  }
+  for (G4int m = 2; m <= 4; ++m) {
+    if (multiplicity == "all" || multiplicity == std::to_string(m)) multiplicities.push_back(m);
+  }
+  return !particles.empty() && !multiplicities.empty();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MultipleIonisationMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  std::istringstream is(newValue);
+  G4String particle, multiplicity;
+  is >> particle >> multiplicity;
+  std::vector<G4int> particles;
+  std::vector<G4int> multiplicities;
+  if (!Select(particle, multiplicity, particles, multiplicities)) return;
+
+  if (command == fEnableCmd) {
+    G4String enable;
+    is >> enable;
+    for (G4int i : particles) {
+      for (G4int m : multiplicities) {
+        fPhysicsList->SetMultipleIonisation(i, m, G4UIcommand::ConvertToBool(enable));
+      }
+    }
+  }
+
+  if (command == fWindowCmd) {
+    G4double minEnergy = 0.;
+    G4double maxEnergy = 0.;
+    G4String unit = "MeV";
+    is >> minEnergy >> maxEnergy >> unit;
+    minEnergy *= G4UIcommand::ValueOf(unit);
+    maxEnergy *= G4UIcommand::ValueOf(unit);
+    for (G4int i : particles) {
+      for (G4int m : multiplicities) {
+        fPhysicsList->SetMultipleIonisationWindow(i, m, minEnergy, maxEnergy);
+      }
+    }
+  }
+
+  if (command == fBiasCmd) {
+    G4double factor = 1.;
+    is >> factor;
+    for (G4int i : particles) {
+      for (G4int m : multiplicities) {
+        fPhysicsList->SetMultipleIonisationBias(i, m, factor);
+      }
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
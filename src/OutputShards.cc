@@ -0,0 +1,179 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file OutputShards.cc
+/// \brief Implementation of the OutputShards class
+
+#include "OutputShards.hh"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+void Transfer(const fs::path& from, const fs::path& to, G4bool move)
+{
+  if (move) {
+    fs::rename(from, to);
+  }
+  else {
+    fs::copy(from, to, fs::copy_options::recursive);
+  }
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool OutputShards::IsOutput(const std::string& name)
+{
+  static const std::regex pattern(
+    "dna(_[cs][0-9]+)?(_t[0-9]+)?\\.root|dna\\.(manifest|columns|lineal|dose|radial)");
+  return std::regex_match(name, pattern);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OutputShards::RemoveOutputs()
+{
+  std::vector<fs::path> outputs;
+  for (const auto& entry : fs::directory_iterator(".")) {
+    if (IsOutput(entry.path().filename().string())) outputs.push_back(entry.path());
+  }
+  for (const auto& output : outputs) {
+    fs::remove_all(output);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OutputShards::Add(const std::string& directory, const std::string& tag, G4int nofEvents)
+{
+  Part part;
+  part.directory = directory;
+  part.tag = tag;
+  part.events = nofEvents;
+  fParts.push_back(part);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OutputShards::Combine(G4bool move, const std::string& title) const
+{
+  std::ostringstream header;
+  std::ostringstream shards;
+  G4bool columnar = false;
+  G4int nofEvents = 0;
+  for (std::size_t k = 0; k < fParts.size(); ++k) {
+    const Part& part = fParts[k];
+    fs::path path(part.directory);
+    nofEvents += part.events;
+
+    // Shards of the part, from its manifest, or its merged output
+    std::vector<std::pair<std::string, G4int>> suffixes;
+    std::vector<std::string> masters;
+    std::ifstream manifest(path / "dna.manifest");
+    std::string line;
+    while (std::getline(manifest, line)) {
+      std::istringstream tokens(line);
+      std::string key;
+      tokens >> key;
+      if (key == "shard") {
+        G4int threadID = 0;
+        G4int events = 0;
+        std::string suffix;
+        tokens >> threadID >> events >> suffix;
+        suffixes.emplace_back(suffix, events);
+      }
+      if (key == "master") {
+        std::string file;
+        tokens >> file;
+        masters.push_back(file);
+      }
+      if (k == 0 && (key == "schema" || key == "sampling")) header << line << '\n';
+    }
+    if (suffixes.empty()) suffixes.emplace_back("", part.events);
+
+    for (const auto& suffix : suffixes) {
+      shards << "shard " << k << ' ' << suffix.second << ' ' << part.tag << suffix.first << '\n';
+    }
+
+    if (fs::is_directory(path / "dna.columns")) {
+      // One directory per table and shard, e.g. step_r0_t3, renamed after
+      // the suffix listed in the manifest, e.g. step_s1_r0_t3
+      columnar = true;
+      fs::create_directories("dna.columns");
+      for (const auto& suffix : suffixes) {
+        for (const char* table : {"step", "track", "meta", "cluster"}) {
+          fs::path from = path / "dna.columns" / (table + suffix.first);
+          if (!fs::is_directory(from)) continue;
+          Transfer(from, fs::path("dna.columns") / (table + part.tag + suffix.first), move);
+        }
+      }
+    }
+    else {
+      for (const auto& suffix : suffixes) {
+        Transfer(path / ("dna" + suffix.first + ".root"),
+                 "dna" + part.tag + suffix.first + ".root", move);
+      }
+
+      // Histograms and meta ntuple of the master of the part, unless it is
+      // also its only shard (sequential run)
+      for (const auto& master : masters) {
+        auto isShard = [&master](const std::pair<std::string, G4int>& suffix) {
+          return master == "dna" + suffix.first + ".root";
+        };
+        if (std::any_of(suffixes.begin(), suffixes.end(), isShard)) continue;
+        Transfer(path / master, "dna" + part.tag + ".root", move);
+        shards << "master dna" << part.tag << ".root" << '\n';
+      }
+    }
+  }
+
+  std::ofstream manifest("dna.manifest");
+  manifest << "# dnaphysics output shards (" << title << ")" << '\n';
+  manifest << "name dna" << '\n';
+  manifest << "format " << (columnar ? "columnar" : "root") << '\n';
+  manifest << header.str();
+  manifest << "events " << nofEvents << '\n';
+  manifest << shards.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
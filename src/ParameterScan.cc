@@ -0,0 +1,180 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ParameterScan.cc
+/// \brief Implementation of the ParameterScan class
+
+#include "ParameterScan.hh"
+#include "ParameterScanMessenger.hh"
+
+#include "OutputShards.hh"
+#include "RunAction.hh"
+
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UImanager.hh"
+#include "G4UnitsTable.hh"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+const char* const kDirectory = "dna.scan";
+
+// Exact value for the commands (and material names) of a point
+std::string Format(G4double value)
+{
+  std::ostringstream stream;
+  stream << std::setprecision(std::numeric_limits<G4double>::max_digits10) << value;
+  return stream.str();
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ParameterScan::ParameterScan(RunAction* runAction) : fRunAction(runAction)
+{
+  fMessenger = new ParameterScanMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ParameterScan::~ParameterScan()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ParameterScan::Clear()
+{
+  fEnergies.clear();
+  fParticles.clear();
+  fDensities.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ParameterScan::BeamOn(G4int nofEvents)
+{
+  // Empty lists: one value, the current setting
+  std::vector<G4double> densities = fDensities;
+  std::vector<G4String> particles = fParticles;
+  std::vector<G4double> energies = fEnergies;
+  if (densities.empty()) densities.push_back(-1.);
+  if (particles.empty()) particles.emplace_back();
+  if (energies.empty()) energies.push_back(-1.);
+  std::size_t nofPoints = densities.size() * particles.size() * energies.size();
+
+  std::error_code error;
+  fs::remove_all(kDirectory, error);
+  fs::create_directories(kDirectory, error);
+  std::ofstream points(fs::path(kDirectory) / "points");
+  points << "# point particle energy(MeV) density(g/cm3) events time(s)" << '\n';
+
+  auto UImanager = G4UImanager::GetUIpointer();
+  auto runManager = G4RunManager::GetRunManager();
+  G4int point = 0;
+
+  // Only the values that change between points are applied
+  G4String lastParticle;
+  G4double lastEnergy = -1.;
+  for (G4double density : densities) {
+    // New material: its tables are built at the next run, the others are kept
+    if (density > 0.) {
+      std::string value = Format(density / (g / cm3));
+      UImanager->ApplyCommand("/dna/test/setMatDens Water_" + value + " " + value + " g/cm3");
+    }
+    for (const auto& particle : particles) {
+      if (!particle.empty() && particle != lastParticle) {
+        UImanager->ApplyCommand("/gun/particle " + particle);
+        lastParticle = particle;
+      }
+      for (G4double energy : energies) {
+        if (energy > 0. && energy != lastEnergy) {
+          UImanager->ApplyCommand("/gun/energy " + Format(energy / eV) + " eV");
+          lastEnergy = energy;
+        }
+
+        G4cout << "--- Scan point " << point << " of " << nofPoints << ":";
+        if (!particle.empty()) G4cout << " " << particle;
+        if (energy > 0.) G4cout << " " << G4BestUnit(energy, "Energy");
+        if (density > 0.) G4cout << " " << density / (g / cm3) << " g/cm3";
+        G4cout << G4endl;
+
+        auto start = std::chrono::steady_clock::now();
+        if (fCached) {
+          fRunAction->GetRunCache().BeamOn(nofEvents);
+        }
+        else {
+          runManager->BeamOn(nofEvents);
+        }
+        std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - start;
+
+        // Output of the point, before the next run overwrites it
+        fs::path directory = fs::path(kDirectory) / ("point" + std::to_string(point));
+        try {
+          fs::create_directories(directory);
+          for (const auto& entry : fs::directory_iterator(".")) {
+            fs::path name = entry.path().filename();
+            if (OutputShards::IsOutput(name.string())) fs::rename(entry.path(), directory / name);
+          }
+        }
+        catch (const fs::filesystem_error& exception) {
+          G4ExceptionDescription description;
+          description << "Cannot move the output of scan point " << point << ": "
+                      << exception.what();
+          G4Exception("ParameterScan::BeamOn()", "dnaphysics011", JustWarning, description);
+        }
+
+        points << point << ' ' << (particle.empty() ? "-" : particle) << ' '
+               << (energy > 0. ? energy / MeV : -1.) << ' '
+               << (density > 0. ? density / (g / cm3) : -1.) << ' '
+               << nofEvents << ' ' << elapsed.count() << '\n';
+        ++point;
+      }
+    }
+  }
+  G4cout << "--- Scan: " << point << " points written to " << kDirectory << "/point*" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,189 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ParameterScanMessenger.cc
+/// \brief Implementation of the ParameterScanMessenger class
+
+#include "ParameterScanMessenger.hh"
+#include "ParameterScan.hh"
+
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ParameterScanMessenger::ParameterScanMessenger(ParameterScan* scan) : fScan(scan)
+{
+  fScanDir = new G4UIdirectory("/dna/test/scan/");
+  fScanDir->SetGuidance("scan of the gun and material in one session");
+
+  fEnergiesCmd = new G4UIcmdWithAString("/dna/test/scan/energies", this);
+  fEnergiesCmd->SetGuidance("Gun energies of the scan, with their unit (default MeV),");
+  fEnergiesCmd->SetGuidance("e.g. 1 10 100 keV; none: keep the gun energy.");
+  fEnergiesCmd->SetParameterName("energies", false);
+  fEnergiesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEnergiesCmd->SetToBeBroadcasted(false);
+
+  fParticlesCmd = new G4UIcmdWithAString("/dna/test/scan/particles", this);
+  fParticlesCmd->SetGuidance("Gun particles of the scan, e.g. e- proton alpha;");
+  fParticlesCmd->SetGuidance("none: keep the gun particle.");
+  fParticlesCmd->SetParameterName("particles", false);
+  fParticlesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fParticlesCmd->SetToBeBroadcasted(false);
+
+  fDensitiesCmd = new G4UIcmdWithAString("/dna/test/scan/densities", this);
+  fDensitiesCmd->SetGuidance("Water densities of the scan, with their unit (default g/cm3),");
+  fDensitiesCmd->SetGuidance("e.g. 0.5 1 2 g/cm3; none: keep the material.");
+  fDensitiesCmd->SetGuidance("Each density is a new material: only its tables are built.");
+  fDensitiesCmd->SetParameterName("densities", false);
+  fDensitiesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fDensitiesCmd->SetToBeBroadcasted(false);
+
+  fCachedCmd = new G4UIcmdWithABool("/dna/test/scan/cache", this);
+  fCachedCmd->SetGuidance("Run the points with /dna/cache/beamOn (default false).");
+  fCachedCmd->SetParameterName("cache", true);
+  fCachedCmd->SetDefaultValue(true);
+  fCachedCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fCachedCmd->SetToBeBroadcasted(false);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/dna/test/scan/clear", this);
+  fClearCmd->SetGuidance("Clear the energies, particles and densities of the scan.");
+  fClearCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fClearCmd->SetToBeBroadcasted(false);
+
+  fBeamOnCmd = new G4UIcmdWithAnInteger("/dna/test/scan/beamOn", this);
+  fBeamOnCmd->SetGuidance("Run the events for each point of the scan");
+  fBeamOnCmd->SetGuidance("(densities x particles x energies); the output of point i");
+  fBeamOnCmd->SetGuidance("is moved to dna.scan/point<i>, listed in dna.scan/points.");
+  fBeamOnCmd->SetParameterName("events", false);
+  fBeamOnCmd->SetRange("events>0");
+  fBeamOnCmd->AvailableForStates(G4State_Idle);
+  fBeamOnCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ParameterScanMessenger::~ParameterScanMessenger()
+{
+  delete fEnergiesCmd;
+  delete fParticlesCmd;
+  delete fDensitiesCmd;
+  delete fCachedCmd;
+  delete fClearCmd;
+  delete fBeamOnCmd;
+  delete fScanDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<G4double> ParameterScanMessenger::ParseValues(const G4String& list,
+                                                          const char* category) const
+{
+  std::vector<G4double> values;
+  std::istringstream is(list);
+  G4String token;
+  while (is >> token) {
+    std::istringstream number(token);
+    G4double value = 0.;
+    if (number >> value) {
+      values.push_back(value);
+      continue;
+    }
+
+    // Unit, last in the list
+    if (token == "none") return {};
+    if (G4UIcommand::CategoryOf(token) != category) {
+      G4ExceptionDescription description;
+      description << token << " is not a unit of " << category << "; list ignored.";
+      G4Exception("ParameterScanMessenger::ParseValues()", "dnaphysics011", JustWarning,
+                  description);
+      return {};
+    }
+    for (auto& entry : values) {
+      entry *= G4UIcommand::ValueOf(token);
+    }
+    return values;
+  }
+
+  // Default unit
+  G4double unit = G4UIcommand::ValueOf(G4String(category) == "Energy" ? "MeV" : "g/cm3");
+  for (auto& entry : values) {
+    entry *= unit;
+  }
+  return values;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ParameterScanMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fEnergiesCmd) {
+    fScan->SetEnergies(ParseValues(newValue, "Energy"));
+  }
+
+  if (command == fParticlesCmd) {
+    std::vector<G4String> particles;
+    std::istringstream is(newValue);
+    G4String particle;
+    while (is >> particle) {
+      if (particle != "none") particles.push_back(particle);
+    }
+    fScan->SetParticles(particles);
+  }
+
+  if (command == fDensitiesCmd) {
+    fScan->SetDensities(ParseValues(newValue, "Volumic Mass"));
+  }
+
+  if (command == fCachedCmd) {
+    fScan->SetCached(fCachedCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fClearCmd) {
+    fScan->Clear();
+  }
+
+  if (command == fBeamOnCmd) {
+    fScan->BeamOn(fBeamOnCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -37,6 +37,7 @@
 /// \brief Implementation of the PhysicsList class
 
 #include "PhysicsList.hh"
+#include "MultipleIonisationMessenger.hh"
 
 #include "G4DecayPhysics.hh"
 #include "G4EmDNABuilder.hh"
@@ -59,6 +60,10 @@
 #include "G4RadioactiveDecayPhysics.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4NuclideTable.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4Threading.hh"
 
 // multiple ionisation processes
 #include "G4Version.hh"
@@ -87,6 +92,15 @@ PhysicsList::PhysicsList() : G4VModularPhysicsList()
   // Limits in G4NuclideTable
   G4NuclideTable::GetInstance()->SetThresholdOfHalfLife(0.1 * picosecond);
   G4NuclideTable::GetInstance()->SetLevelTolerance(1.0 * eV);
+
+  // Multiple ionisation of all the ions but hydrogen, at all energies
+  for (G4int particle = 0; particle < kNMIParticles; ++particle) {
+    for (G4int m = 0; m < 3; ++m) {
+      fMIEnabled[particle][m] = (particle != 3);
+      fMIBias[particle][m] = 1.;
+    }
+  }
+  fMIMessenger = new MultipleIonisationMessenger(this);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -96,6 +110,7 @@ PhysicsList::~PhysicsList()
   delete fEmPhysicsList;
   delete fDecayPhysicsList;
   delete fRadDecayPhysicsList;
+  delete fMIMessenger;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -120,6 +135,41 @@ void PhysicsList::ConstructProcess()
   if (fIsTrackingCutSet) {
     TrackingCut();
   }
+  if (!fScopePrimaries.empty()) {
+    ApplyPhysicsScope();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsList::SetCuts()
+{
+  G4VModularPhysicsList::SetCuts();
+
+  // The tables are built (or retrieved) by the master, shared by the workers
+  if (G4Threading::IsMasterThread()) fTableCache.Retrieve(GetConstructorNames(), this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PhysicsList::GetConstructorNames() const
+{
+  G4String names = fEmPhysicsList->GetPhysicsName() + " " + fDecayPhysicsList->GetPhysicsName();
+  if (nullptr != fRadDecayPhysicsList) names += " " + fRadDecayPhysicsList->GetPhysicsName();
+  names += " multipleIonisation";
+  for (G4int particle = 0; particle < kNMIParticles; ++particle) {
+    for (G4int m = 0; m < 3; ++m) {
+      if (fMIEnabled[particle][m]) names += " " + std::to_string(particle * 10 + m + 2);
+    }
+  }
+  if (fIsTrackingCutSet) names += " ionsTrackingCut";
+  if (!fScopePrimaries.empty()) {
+    names += " scope";
+    for (const auto& name : GetScopeParticles()) {
+      names += " " + name;
+    }
+  }
+  return names;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -222,53 +272,180 @@ void PhysicsList::SetTrackingCut(G4bool isCut)
 
 void PhysicsList::ConstructMultipleIonisationProcess()
 {
-  auto BuildDoubleIonisation = [](const std::string& name,
-                                  G4ParticleDefinition* part) {
-    auto* ph = G4PhysicsListHelper::GetPhysicsListHelper();
-    if (!ph->RegisterProcess(new G4DNADoubleIonisation(name), part)) {
-      std::cout << "[WARNNING] Failed to set " << name << std::endl;
+  static const char* const multiplicityNames[3] = {"Double", "Triple", "Quadruple"};
+  auto* ph = G4PhysicsListHelper::GetPhysicsListHelper();
+
+  for (G4int particle = 0; particle < kNMIParticles; ++particle) {
+    G4ParticleDefinition* definition = nullptr;
+    if (particle == 0) definition = G4Proton::Proton();
+    if (particle == 1) definition = G4Alpha::Alpha();
+    if (particle == 2) definition = G4GenericIon::GenericIon();
+#if G4VERSION_NUMBER >= 1132 && G4VERSION_REFERENCE_TAG >= 6
+    // for hydrogen atoms
+    if (particle == 3) definition = G4DNAGenericIonsManager::Instance()->GetIon("hydrogen");
+#endif
+    if (nullptr == definition) continue;
+
+    for (G4int m = 0; m < 3; ++m) {
+      if (!fMIEnabled[particle][m]) continue;
+
+      G4String name =
+        definition->GetParticleName() + "_G4DNA" + multiplicityNames[m] + "Ionisation";
+      G4VProcess* process = nullptr;
+      if (m == 0) process = new G4DNADoubleIonisation(name);
+      if (m == 1) process = new G4DNATripleIonisation(name);
+      if (m == 2) process = new G4DNAQuadrupleIonisation(name);
+
+      // Outside of its energy window the cross section is not computed,
+      // inside it is enhanced by the biasing factor
+      auto windowProcess =
+        new EnergyWindowProcess(process, &fMIWindows[particle][m], &fMIBias[particle][m]);
+      if (!ph->RegisterProcess(windowProcess, definition) && G4Threading::IsMasterThread()) {
+        G4ExceptionDescription msg;
+        msg << "Failed to register " << name << "; disable it with /dna/mi/enable "
+            << definition->GetParticleName() << ' ' << m + 2 << " false";
+        G4Exception("PhysicsList::ConstructMultipleIonisationProcess()", "dnaphysics013",
+                    JustWarning, msg);
+      }
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int PhysicsList::GetMIParticleIndex(const G4String& name)
+{
+  if (name == "proton") return 0;
+  if (name == "alpha") return 1;
+  if (name == "GenericIon" || name == "ion") return 2;
+  if (name == "hydrogen") return 3;
+  return -1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsList::SetMultipleIonisation(G4int particle, G4int multiplicity, G4bool enabled)
+{
+  fMIEnabled[particle][multiplicity - 2] = enabled;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsList::SetMultipleIonisationWindow(G4int particle, G4int multiplicity,
+                                              G4double minEnergy, G4double maxEnergy)
+{
+  fMIWindows[particle][multiplicity - 2].minEnergy = minEnergy;
+  fMIWindows[particle][multiplicity - 2].maxEnergy = maxEnergy;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsList::SetMultipleIonisationBias(G4int particle, G4int multiplicity, G4double factor)
+{
+  fMIBias[particle][multiplicity - 2] = factor;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhysicsList::IsMultipleIonisationBiased() const
+{
+  for (G4int particle = 0; particle < kNMIParticles; ++particle) {
+    for (G4int m = 0; m < 3; ++m) {
+      if (fMIEnabled[particle][m] && fMIBias[particle][m] != 1.) return true;
     }
-  };
+  }
+  return false;
+}
 
-  auto BuildTripleIonisation = [](const std::string& name,
-                                  G4ParticleDefinition* part) {
-    auto* ph = G4PhysicsListHelper::GetPhysicsListHelper();
-    if (!ph->RegisterProcess(new G4DNATripleIonisation(name), part)) {
-      std::cout << "[WARNNING] Failed to set " << name << std::endl;
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsList::SetPhysicsScope(const std::vector<G4String>& primaries, G4double maxEnergy)
+{
+  fScopePrimaries.clear();
+  for (const auto& primary : primaries) {
+    if (primary == "all") {
+      fScopePrimaries.clear();
+      return;
     }
-  };
+    fScopePrimaries.push_back(primary);
+  }
+  fScopeMaxEnergy = maxEnergy;
+}
 
-  auto BuildQuadrupleIonisation = [](const std::string& name,
-                                     G4ParticleDefinition* part) {
-    auto* ph = G4PhysicsListHelper::GetPhysicsListHelper();
-    if (!ph->RegisterProcess(new G4DNAQuadrupleIonisation(name), part)) {
-      std::cout << "[WARNNING] Failed to set " << name << std::endl;
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::set<G4String> PhysicsList::GetScopeParticles() const
+{
+  // Delta electrons and photons (bremsstrahlung, fluorescence) from any
+  // primary; positrons from photons above the pair production threshold
+  std::set<G4String> particles = {"e-", "gamma"};
+  if (fScopeMaxEnergy <= 0. || fScopeMaxEnergy > 2. * electron_mass_c2) {
+    particles.insert("e+");
+  }
+
+  for (const auto& primary : fScopePrimaries) {
+    if (primary == "e-" || primary == "gamma" || primary == "e+") {
+      particles.insert(primary);
+    }
+    else if (primary == "proton" || primary == "hydrogen") {
+      // Charge change processes
+      particles.insert({"proton", "hydrogen"});
     }
-  };
-
-  // for protons
-  auto* proton = G4Proton::Proton();
-  BuildDoubleIonisation("proton_G4DNADoubleIonisation", proton);
-  BuildTripleIonisation("proton_G4DNATripleIonisation", proton);
-  BuildQuadrupleIonisation("proton_G4DNAQuadrupleIonisation", proton);
-
-  // for alpha particles
-  auto* alphapp = G4Alpha::Alpha();
-  BuildDoubleIonisation("alpha_G4DNADoubleIonisation", alphapp);
-  BuildTripleIonisation("alpha_G4DNATripleIonisation", alphapp);
-  BuildQuadrupleIonisation("alpha_G4DNAQuadrupleIonisation", alphapp);
-
-  // for carbon ions
-  auto* gion = G4GenericIon::GenericIon();
-  BuildDoubleIonisation("GenericIon_G4DNADoubleIonisation", gion);
-  BuildTripleIonisation("GenericIon_G4DNATripleIonisation", gion);
-  BuildQuadrupleIonisation("GenericIon_G4DNAQuadrupleIonisation", gion);
+    else if (primary == "alpha" || primary == "alpha+" || primary == "helium") {
+      particles.insert({"alpha", "alpha+", "helium"});
+    }
+    else if ((primary == "ion" || primary == "GenericIon") && nullptr == fRadDecayPhysicsList) {
+      particles.insert("GenericIon");
+    }
+    else {
+      // Decay chains of the radioactive ions, or other particles: all
+      return {};
+    }
+  }
+  return particles;
+}
 
-#if G4VERSION_NUMBER >= 1132 && G4VERSION_REFERENCE_TAG >= 6
-  // for hydrogen atoms
-  auto* hydrogen = G4DNAGenericIonsManager::Instance()->GetIon("hydrogen");
-  BuildDoubleIonisation("hydrogen_G4DNADoubleIonisation", hydrogen);
-  BuildTripleIonisation("hydrogen_G4DNATripleIonisation", hydrogen);
-  BuildQuadrupleIonisation("hydrogen_G4DNAQuadrupleIonisation", hydrogen);
-#endif
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsList::ApplyPhysicsScope()
+{
+  std::set<G4String> scope = GetScopeParticles();
+  if (scope.empty()) return;
+
+  // The processes of the other particles are removed before the physics
+  // tables are built, so that their tables and model data are never made.
+  // They are not deleted: the EM managers of Geant4 still refer to them.
+  G4int nofParticles = 0;
+  G4int nofProcesses = 0;
+  auto particleIterator = GetParticleIterator();
+  particleIterator->reset();
+  while ((*particleIterator)()) {
+    G4ParticleDefinition* particle = particleIterator->value();
+    G4ProcessManager* manager = particle->GetProcessManager();
+    if (nullptr == manager || scope.count(particle->GetParticleName()) > 0) continue;
+
+    std::vector<G4VProcess*> removed;
+    G4ProcessVector* processes = manager->GetProcessList();
+    for (G4int i = 0; i < (G4int)processes->size(); ++i) {
+      if ((*processes)[i]->GetProcessType() != fTransportation) removed.push_back((*processes)[i]);
+    }
+    for (auto process : removed) {
+      manager->RemoveProcess(process);
+    }
+    if (!removed.empty()) {
+      ++nofParticles;
+      nofProcesses += (G4int)removed.size();
+    }
+  }
+
+  if (G4Threading::IsMasterThread()) {
+    G4cout << "--- Physics scope:";
+    for (const auto& name : scope) {
+      G4cout << " " << name;
+    }
+    G4cout << " (" << nofProcesses << " processes of " << nofParticles
+           << " other particles removed)" << G4endl;
+  }
 }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
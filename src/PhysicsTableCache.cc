@@ -0,0 +1,163 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file PhysicsTableCache.cc
+/// \brief Implementation of the PhysicsTableCache class
+
+#include "PhysicsTableCache.hh"
+
+#include "G4EmParameters.hh"
+#include "G4Material.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VUserPhysicsList.hh"
+#include "G4Version.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::string PhysicsTableCache::GetConfiguration(const G4String& constructors,
+                                                const G4VUserPhysicsList* physicsList) const
+{
+  std::ostringstream configuration;
+  configuration << std::setprecision(12);
+  configuration << "geant4 " << G4VERSION_NUMBER << ' ' << G4VERSION_TAG << '\n';
+
+  // Data sets read when the tables are built: their directories carry the
+  // versions (e.g. G4EMLOW8.6.1)
+  for (const char* variable :
+       {"G4LEDATA", "G4LEVELGAMMADATA", "G4RADIOACTIVEDATA", "G4ENSDFSTATEDATA",
+        "G4PARTICLEXSDATA", "G4NEUTRONHPDATA", "G4PIIDATA", "G4SAIDXSDATA", "G4ABLADATA",
+        "G4INCLDATA", "G4REALSURFACEDATA", "G4CHANNELINGDATA"})
+  {
+    const char* value = std::getenv(variable);
+    if (value == nullptr) continue;
+    std::error_code error;
+    fs::path directory = fs::canonical(value, error);
+    configuration << "data " << variable << ' ' << (error ? fs::path(value) : directory).string()
+                  << '\n';
+  }
+  configuration << "physics " << constructors << '\n';
+  configuration << "cut " << physicsList->GetDefaultCutValue() / nm << " nm\n";
+
+  auto cutsTable = G4ProductionCutsTable::GetProductionCutsTable();
+  configuration << "cut energy range " << cutsTable->GetLowEdgeEnergy() / eV << ' '
+                << cutsTable->GetHighEdgeEnergy() / eV << " eV\n";
+
+  // Energy range, bins and options of the EM processes
+  G4EmParameters::Instance()->StreamInfo(configuration);
+
+  for (const auto material : *G4Material::GetMaterialTable()) {
+    configuration << "material " << material->GetName() << ' '
+                  << material->GetDensity() / (g / cm3) << " g/cm3\n";
+  }
+  return configuration.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::string PhysicsTableCache::GetKey(const G4String& constructors,
+                                      const G4VUserPhysicsList* physicsList) const
+{
+  // FNV-1a
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (unsigned char c : GetConfiguration(constructors, physicsList)) {
+    hash = (hash ^ c) * 0x100000001b3ULL;
+  }
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsTableCache::Retrieve(const G4String& constructors, G4VUserPhysicsList* physicsList)
+{
+  fPendingDirectory.clear();
+  if (!IsActive()) return;
+
+  std::string directory = fDirectory + "/" + GetKey(constructors, physicsList);
+
+  // Tables completely stored by a previous start
+  if (fs::exists(fs::path(directory) / "complete")) {
+    physicsList->SetPhysicsTableRetrieved(directory);
+    G4cout << "--- Physics tables retrieved from " << directory << G4endl;
+    return;
+  }
+
+  fPendingDirectory = directory;
+  fPendingConfiguration = GetConfiguration(constructors, physicsList);
+  G4cout << "--- Physics tables will be stored in " << directory << " after the first run"
+         << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsTableCache::Store(G4VUserPhysicsList* physicsList)
+{
+  if (fPendingDirectory.empty()) return;
+  std::string directory = fPendingDirectory;
+  fPendingDirectory.clear();
+
+  auto start = std::chrono::steady_clock::now();
+  std::error_code error;
+  fs::remove_all(directory, error);
+  fs::create_directories(directory, error);
+  if (error || !physicsList->StorePhysicsTable(directory)) {
+    G4ExceptionDescription description;
+    description << "Cannot store the physics tables in " << directory;
+    G4Exception("PhysicsTableCache::Store()", "dnaphysics012", JustWarning, description);
+    return;
+  }
+  std::ofstream(fs::path(directory) / "configuration") << fPendingConfiguration;
+
+  // Written last: the tables are complete
+  std::ofstream(fs::path(directory) / "complete") << "complete" << '\n';
+
+  std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - start;
+  G4cout << "--- Physics tables stored in " << directory << " (" << elapsed.count() << " s)"
+         << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
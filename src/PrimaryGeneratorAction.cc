@@ -38,9 +38,16 @@
 
 #include "PrimaryGeneratorAction.hh"
 
+#include "Run.hh"
+#include "RunAction.hh"
+
+#include "G4Event.hh"
+#include "G4RunManager.hh"
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-PrimaryGeneratorAction::PrimaryGeneratorAction() : G4VUserPrimaryGeneratorAction(), fpParticleGun(0)
+PrimaryGeneratorAction::PrimaryGeneratorAction(RunAction* runAction)
+  : G4VUserPrimaryGeneratorAction(), fpParticleGun(0), fRunAction(runAction)
 {
   G4int n_particle = 1;
   fpParticleGun = new G4ParticleGun(n_particle);
@@ -57,5 +64,27 @@ PrimaryGeneratorAction::~PrimaryGeneratorAction()
 
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 {
+  // Busy time of the thread (see RunAction::PrintLoadBalance)
+  auto run = static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+  run->StartEventTimer();
+
+  // Events of the cached and checkpointed runs are seeded from their
+  // global event ID; the events already completed before a resume are skipped
+  const EventSeeder& seeder = fRunAction->GetEventSeeder();
+  G4int eventID = seeder.GetGlobalEventID(anEvent->GetEventID());
+  if (eventID < 0) {
+    run->SkipEvent();
+    return;
+  }
+  if (seeder.IsActive()) seeder.SeedEvent(eventID);
+
+  // Single-collision mode: the event has no primary vertex
+  FirstInteractionSampler& sampler = fRunAction->GetFirstInteractionSampler();
+  if (sampler.IsActive()) {
+    G4int n = sampler.Sample(*fpParticleGun, eventID, *fRunAction);
+    run->AddFirstInteractions(n);
+    return;
+  }
+
   fpParticleGun->GeneratePrimaryVertex(anEvent);
 }
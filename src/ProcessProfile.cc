@@ -0,0 +1,160 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ProcessProfile.cc
+/// \brief Implementation of the ProcessProfile class
+
+#include "ProcessProfile.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProcessProfile::Configure()
+{
+  fEntries.assign(kNParticles * kNProcesses, Entry());
+  fNames.assign(kNParticles * kNProcesses, G4String());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProcessProfile::Merge(const ProcessProfile& other)
+{
+  if (!other.IsConfigured()) return;
+  if (!IsConfigured()) Configure();
+
+  for (std::size_t i = 0; i < fEntries.size(); ++i) {
+    fEntries[i].steps += other.fEntries[i].steps;
+    fEntries[i].energy += other.fEntries[i].energy;
+    fEntries[i].time += other.fEntries[i].time;
+    if (fNames[i].empty()) fNames[i] = other.fNames[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<std::size_t> ProcessProfile::SortedEntries() const
+{
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 0; i < fEntries.size(); ++i) {
+    if (fEntries[i].steps > 0) indices.push_back(i);
+  }
+  std::sort(indices.begin(), indices.end(), [this](std::size_t a, std::size_t b) {
+    return fEntries[a].time > fEntries[b].time;
+  });
+  return indices;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String ProcessProfile::ParticleName(std::size_t index) const
+{
+  static const char* names[kNParticles] = {"gamma", "e-",     "proton", "hydrogen", "alpha",
+                                           "alpha+", "helium", "ion",    "other"};
+  return names[index / kNProcesses];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String ProcessProfile::ProcessName(std::size_t index) const
+{
+  G4int process = index % kNProcesses;
+  G4String name = fNames[index].empty() ? "-" : fNames[index];
+  if (process == kTransportation) return name;
+  if (process == kOtherProcess) return "unclassified " + name;
+  return std::to_string(process) + " " + name;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProcessProfile::Print() const
+{
+  if (!IsConfigured()) return;
+
+  G4long totalSteps = 0;
+  G4double totalTime = 0.;
+  for (const auto& entry : fEntries) {
+    totalSteps += entry.steps;
+    totalTime += entry.time;
+  }
+
+  G4cout << "--- Steps per particle and process (sampled time):" << G4endl;
+  G4cout << "    " << std::left << std::setw(10) << "particle" << std::setw(40) << "process"
+         << std::right << std::setw(14) << "steps" << std::setw(14) << "edep (keV)"
+         << std::setw(12) << "time (s)" << std::setw(8) << "time %" << G4endl;
+
+  for (std::size_t i : SortedEntries()) {
+    const Entry& entry = fEntries[i];
+    G4double fraction = totalTime > 0. ? 100. * entry.time / totalTime : 0.;
+    G4cout << "    " << std::left << std::setw(10) << ParticleName(i) << std::setw(40)
+           << ProcessName(i) << std::right << std::setw(14) << entry.steps << std::setw(14)
+           << std::setprecision(6) << entry.energy / keV << std::setw(12) << entry.time
+           << std::setw(8) << std::setprecision(3) << fraction << G4endl;
+  }
+  G4cout << std::setprecision(6) << "    total: " << totalSteps << " steps, " << totalTime
+         << " s" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ProcessProfile::WriteJson(const G4String& fileName) const
+{
+  if (!IsConfigured()) return;
+
+  std::ofstream file(fileName);
+  file << std::setprecision(9);
+  file << "[\n";
+  G4bool first = true;
+  for (std::size_t i : SortedEntries()) {
+    const Entry& entry = fEntries[i];
+    G4int particle = i / kNProcesses;
+    G4int process = i % kNProcesses;
+    if (!first) file << ",\n";
+    first = false;
+    file << "  {\"particle\": \"" << ParticleName(i) << "\", \"flagParticle\": "
+         << (particle < kNParticles - 1 ? particle : -1) << ", \"flagProcess\": "
+         << (process < kNProcessFlags ? process : -1) << ", \"process\": \""
+         << fNames[i]
+         << "\", \"steps\": " << entry.steps << ", \"energyDeposit_keV\": " << entry.energy / keV
+         << ", \"time_s\": " << entry.time << "}";
+  }
+  file << "\n]\n";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
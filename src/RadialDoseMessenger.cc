@@ -0,0 +1,90 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file RadialDoseMessenger.cc
+/// \brief Implementation of the RadialDoseMessenger class
+
+#include "RadialDoseMessenger.hh"
+#include "RadialDoseScorer.hh"
+
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIdirectory.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RadialDoseMessenger::RadialDoseMessenger(RadialDoseScorer* scorer) : fScorer(scorer)
+{
+  fRadialDir = new G4UIdirectory("/dna/radial/");
+  fRadialDir->SetGuidance("radial dose around the primary path");
+
+  fActiveCmd = new G4UIcmdWithABool("/dna/radial/activate", this);
+  fActiveCmd->SetGuidance("Score the radial dose around the primary path");
+  fActiveCmd->SetGuidance("(written to dna.radial).");
+  fActiveCmd->SetParameterName("activate", true);
+  fActiveCmd->SetDefaultValue(true);
+  fActiveCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBinsCmd = new G4UIcmdWithAnInteger("/dna/radial/binsPerDecade", this);
+  fBinsCmd->SetGuidance("Number of logarithmic radial bins per decade");
+  fBinsCmd->SetGuidance("(from 0.1 nm to the world size).");
+  fBinsCmd->SetParameterName("bins", false);
+  fBinsCmd->SetRange("bins>0");
+  fBinsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RadialDoseMessenger::~RadialDoseMessenger()
+{
+  delete fActiveCmd;
+  delete fBinsCmd;
+  delete fRadialDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RadialDoseMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fActiveCmd) {
+    fScorer->SetActive(fActiveCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fBinsCmd) {
+    fScorer->SetBinsPerDecade(fBinsCmd->GetNewIntValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
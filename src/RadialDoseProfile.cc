@@ -0,0 +1,120 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file RadialDoseProfile.cc
+/// \brief Implementation of the RadialDoseProfile class
+
+#include "RadialDoseProfile.hh"
+
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+#include <fstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RadialDoseProfile::SetBinning(G4double rMin, G4double rMax, G4int binsPerDecade)
+{
+  fLogRMin = std::log10(rMin);
+  fBinsPerDecade = binsPerDecade;
+  G4int nBins = (G4int)std::ceil((std::log10(rMax) - fLogRMin) * binsPerDecade);
+  fEnergy.assign(nBins, 0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RadialDoseProfile::Fill(G4double r, G4double edep)
+{
+  if (r <= 0.) {
+    fUnderflow += edep;
+    return;
+  }
+
+  G4int bin = (G4int)std::floor((std::log10(r) - fLogRMin) * fBinsPerDecade);
+  if (bin < 0) {
+    fUnderflow += edep;
+  }
+  else if (bin >= (G4int)fEnergy.size()) {
+    fOverflow += edep;
+  }
+  else {
+    fEnergy[bin] += edep;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RadialDoseProfile::Merge(const RadialDoseProfile& other)
+{
+  if (fEnergy.size() != other.fEnergy.size()) {
+    G4Exception("RadialDoseProfile::Merge()", "dnaphysics006", FatalException,
+                "Profiles with different binnings cannot be merged.");
+    return;
+  }
+  for (std::size_t i = 0; i < fEnergy.size(); ++i) {
+    fEnergy[i] += other.fEnergy[i];
+  }
+  fUnderflow += other.fUnderflow;
+  fOverflow += other.fOverflow;
+  fCoreEnergy += other.fCoreEnergy;
+  fPathLength += other.fPathLength;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RadialDoseProfile::Write(const G4String& fileName, G4double density) const
+{
+  std::ofstream out(fileName);
+  out << "# radial dose around the primary path" << '\n';
+  out << "# primary path length " << fPathLength / nm << " nm" << '\n';
+  out << "# core (primary deposits) " << fCoreEnergy / eV << " eV" << '\n';
+  out << "# secondaries below the first bin " << fUnderflow / eV << " eV, beyond the last bin "
+      << fOverflow / eV << " eV" << '\n';
+  out << "# rLow(nm) rHigh(nm) energy(eV) dose(Gy)" << '\n';
+
+  for (std::size_t i = 0; i < fEnergy.size(); ++i) {
+    G4double rLow = std::pow(10., fLogRMin + i / fBinsPerDecade);
+    G4double rHigh = std::pow(10., fLogRMin + (i + 1) / fBinsPerDecade);
+
+    // Mass of the cylindrical shell around the whole primary path
+    G4double mass = density * pi * (rHigh * rHigh - rLow * rLow) * fPathLength;
+    G4double dose = mass > 0. ? fEnergy[i] / mass / gray : 0.;
+
+    out << rLow / nm << ' ' << rHigh / nm << ' ' << fEnergy[i] / eV << ' ' << dose << '\n';
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
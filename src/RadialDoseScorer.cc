@@ -0,0 +1,160 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file RadialDoseScorer.cc
+/// \brief Implementation of the RadialDoseScorer class
+
+#include "RadialDoseScorer.hh"
+
+#include "RadialDoseMessenger.hh"
+#include "RadialDoseProfile.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+// Number of consecutive primary segments sharing a bounding sphere
+const std::size_t kChunkSize = 32;
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RadialDoseScorer::RadialDoseScorer()
+{
+  fMessenger = new RadialDoseMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RadialDoseScorer::~RadialDoseScorer()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RadialDoseScorer::BeginOfEvent()
+{
+  fStarts.clear();
+  fEnds.clear();
+  fCoreEnergy = 0.;
+  fPositions.clear();
+  fEnergies.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RadialDoseScorer::BuildChunks()
+{
+  fChunks.clear();
+  for (std::size_t first = 0; first < fStarts.size(); first += kChunkSize) {
+    Chunk chunk;
+    chunk.first = first;
+    chunk.last = std::min(first + kChunkSize, fStarts.size());
+
+    // Sphere centred on the mean of the end points
+    G4ThreeVector sum;
+    for (std::size_t i = chunk.first; i < chunk.last; ++i) {
+      sum += fStarts[i] + fEnds[i];
+    }
+    chunk.center = sum * (0.5 / (chunk.last - chunk.first));
+
+    for (std::size_t i = chunk.first; i < chunk.last; ++i) {
+      chunk.radius = std::max(chunk.radius, (fStarts[i] - chunk.center).mag());
+      chunk.radius = std::max(chunk.radius, (fEnds[i] - chunk.center).mag());
+    }
+    fChunks.push_back(chunk);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double RadialDoseScorer::DistanceToSegment(const G4ThreeVector& point,
+                                             std::size_t segment) const
+{
+  G4ThreeVector direction = fEnds[segment] - fStarts[segment];
+  G4ThreeVector offset = point - fStarts[segment];
+  G4double length2 = direction.mag2();
+
+  G4double t = length2 > 0. ? offset.dot(direction) / length2 : 0.;
+  t = std::min(1., std::max(0., t));
+  return (offset - direction * t).mag();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double RadialDoseScorer::DistanceToPath(const G4ThreeVector& point) const
+{
+  // Chunks sorted by the lower bound of their distance to the point
+  fBounds.resize(fChunks.size());
+  for (std::size_t c = 0; c < fChunks.size(); ++c) {
+    G4double bound = (point - fChunks[c].center).mag() - fChunks[c].radius;
+    fBounds[c] = {std::max(0., bound), c};
+  }
+  std::sort(fBounds.begin(), fBounds.end());
+
+  G4double best = DBL_MAX;
+  for (const auto& bound : fBounds) {
+    if (bound.first >= best) break;
+    const Chunk& chunk = fChunks[bound.second];
+    for (std::size_t i = chunk.first; i < chunk.last; ++i) {
+      best = std::min(best, DistanceToSegment(point, i));
+    }
+  }
+  return best;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RadialDoseScorer::EndOfEvent(RadialDoseProfile& profile)
+{
+  if (!fActive || fStarts.empty()) return;
+
+  G4double pathLength = 0.;
+  for (std::size_t i = 0; i < fStarts.size(); ++i) {
+    pathLength += (fEnds[i] - fStarts[i]).mag();
+  }
+  profile.AddPathLength(pathLength);
+  profile.AddCore(fCoreEnergy);
+
+  BuildChunks();
+  for (std::size_t i = 0; i < fPositions.size(); ++i) {
+    profile.Fill(DistanceToPath(fPositions[i]), fEnergies[i]);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
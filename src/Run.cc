@@ -0,0 +1,84 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file Run.cc
+/// \brief Implementation of the Run class
+
+#include "Run.hh"
+
+#include "G4Threading.hh"
+
+#include <algorithm>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+Run::Run() : G4Run(), fThreadID(G4Threading::G4GetThreadId()) {}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void Run::Merge(const G4Run* aRun)
+{
+  const Run* localRun = static_cast<const Run*>(aRun);
+
+  Shard shard;
+  shard.threadID = localRun->fThreadID;
+  shard.numberOfEvents = localRun->GetNumberOfEvent() - localRun->fNumberOfSkippedEvents;
+  shard.busyTime = localRun->fBusyTime;
+  fShards.push_back(shard);
+
+  // Workers are merged in completion order
+  std::sort(fShards.begin(), fShards.end(),
+            [](const Shard& a, const Shard& b) { return a.threadID < b.threadID; });
+
+  fLinealEnergySpectrum.Merge(localRun->fLinealEnergySpectrum);
+  if (fRadialDoseProfile.IsConfigured()) {
+    fRadialDoseProfile.Merge(localRun->fRadialDoseProfile);
+  }
+  if (fDoseMesh.IsConfigured()) fDoseMesh.Merge(localRun->fDoseMesh);
+  fProcessProfile.Merge(localRun->fProcessProfile);
+  fNumberOfClusters += localRun->fNumberOfClusters;
+  fNumberOfNoisePoints += localRun->fNumberOfNoisePoints;
+  fNumberOfFirstInteractions += localRun->fNumberOfFirstInteractions;
+  fNumberOfSteps += localRun->fNumberOfSteps;
+  for (G4int m = 0; m < 3; ++m) {
+    fMultipleIonisations[m] += localRun->fMultipleIonisations[m];
+    fMultipleIonisations2[m] += localRun->fMultipleIonisations2[m];
+  }
+  fNumberOfSkippedEvents += localRun->fNumberOfSkippedEvents;
+
+  G4Run::Merge(aRun);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -38,13 +38,32 @@
 
 #include "RunAction.hh"
 
+#include "PhysicsList.hh"
+#include "Run.hh"
+#include "RunMessenger.hh"
+#include "SteppingAction.hh"
+
 #include "G4AnalysisManager.hh"
+#include "G4Material.hh"
 #include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4RunManagerKernel.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-RunAction::RunAction() : G4UserRunAction()
+RunAction::RunAction()
+  : G4UserRunAction(), fVoxelSize(1 * um), fRunCache(this), fCheckpoint(this), fShardSelection(this),
+    fParameterScan(this)
 {
+  fRunMessenger = new RunMessenger(this);
+
   // Create analysis manager
   G4cout << "##### Create analysis manager "
          << "  " << this << G4endl;
@@ -57,24 +76,96 @@ RunAction::RunAction() : G4UserRunAction()
 
   analysisManager->SetVerboseLevel(1);
 
+  // Ntuples are created at the beginning of the first run,
+  // once the schema has been selected (see BookNtuples)
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunAction::~RunAction()
+{
+  delete fRunMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::SetCompactSchema(G4bool compact)
+{
+  if (fNtuplesBooked && compact != fCompactSchema) {
+    G4Exception("RunAction::SetCompactSchema()", "dnaphysics002", JustWarning,
+                "Ntuples are already booked; the schema is only changed before the first run.");
+    return;
+  }
+  fCompactSchema = compact;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::SetOutputFormat(const G4String& format)
+{
+  fColumnarOutput = (format == "columnar");
+  fHistogramOutput = (format == "histograms");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String RunAction::GetOutputFormat() const
+{
+  if (fColumnarOutput) return "columnar";
+  if (fHistogramOutput) return "histograms";
+  return "root";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::BookNtuples()
+{
+  if (fNtuplesBooked) return;
+  fNtuplesBooked = true;
+
+  auto analysisManager = G4AnalysisManager::Instance();
+
   // Creating ntuple
 
   // Step information ntuple
+  // Schema 3 (default): double flags and values
+  // Schema 4 (compact): int flags, float positions (nm) and energies (eV)
+  // Both end with the statistical weight of the step (see /dna/mi/bias)
   analysisManager->CreateNtuple("step", "dnaphysics");
-  analysisManager->CreateNtupleDColumn("flagParticle");
-  analysisManager->CreateNtupleDColumn("flagProcess");
-  analysisManager->CreateNtupleDColumn("x");
-  analysisManager->CreateNtupleDColumn("y");
-  analysisManager->CreateNtupleDColumn("z");
-  analysisManager->CreateNtupleDColumn("totalEnergyDeposit");
-  analysisManager->CreateNtupleDColumn("stepLength");
-  analysisManager->CreateNtupleDColumn("kineticEnergyDifference");
-  analysisManager->CreateNtupleDColumn("kineticEnergy");
-  analysisManager->CreateNtupleDColumn("cosTheta");
+  if (!fCompactSchema) {
+    analysisManager->CreateNtupleDColumn("flagParticle");
+    analysisManager->CreateNtupleDColumn("flagProcess");
+    analysisManager->CreateNtupleDColumn("x");
+    analysisManager->CreateNtupleDColumn("y");
+    analysisManager->CreateNtupleDColumn("z");
+    analysisManager->CreateNtupleDColumn("totalEnergyDeposit");
+    analysisManager->CreateNtupleDColumn("stepLength");
+    analysisManager->CreateNtupleDColumn("kineticEnergyDifference");
+    analysisManager->CreateNtupleDColumn("kineticEnergy");
+    analysisManager->CreateNtupleDColumn("cosTheta");
+  }
+  else {
+    analysisManager->CreateNtupleIColumn("flagParticle");
+    analysisManager->CreateNtupleIColumn("flagProcess");
+    analysisManager->CreateNtupleFColumn("x");
+    analysisManager->CreateNtupleFColumn("y");
+    analysisManager->CreateNtupleFColumn("z");
+    analysisManager->CreateNtupleFColumn("totalEnergyDeposit");
+    analysisManager->CreateNtupleFColumn("stepLength");
+    analysisManager->CreateNtupleFColumn("kineticEnergyDifference");
+    analysisManager->CreateNtupleFColumn("kineticEnergy");
+    analysisManager->CreateNtupleFColumn("cosTheta");
+  }
   analysisManager->CreateNtupleIColumn("eventID");
   analysisManager->CreateNtupleIColumn("trackID");
   analysisManager->CreateNtupleIColumn("parentID");
   analysisManager->CreateNtupleIColumn("stepID");
+  if (!fCompactSchema) {
+    analysisManager->CreateNtupleDColumn("weight");
+  }
+  else {
+    analysisManager->CreateNtupleFColumn("weight");
+  }
   analysisManager->FinishNtuple();
 
   // Track information ntuple
@@ -90,20 +181,433 @@ RunAction::RunAction() : G4UserRunAction()
   analysisManager->CreateNtupleIColumn("trackID");
   analysisManager->CreateNtupleIColumn("parentID");
   analysisManager->FinishNtuple();
+
+  // Run information ntuple: one row per thread and run
+  analysisManager->CreateNtuple("meta", "dnaphysics");
+  analysisManager->CreateNtupleIColumn("schemaVersion");
+  analysisManager->CreateNtupleIColumn("threadID");
+  analysisManager->CreateNtupleIColumn("numberOfEvents");
+  analysisManager->CreateNtupleIColumn("samplingMode");
+  analysisManager->CreateNtupleDColumn("samplingFactor");
+  analysisManager->CreateNtupleIColumn("recordedEvents");
+  analysisManager->FinishNtuple();
+
+  // Cluster ntuple: one row per DBSCAN cluster (see DamageClusterer)
+  analysisManager->CreateNtuple("cluster", "dnaphysics");
+  analysisManager->CreateNtupleIColumn("eventID");
+  analysisManager->CreateNtupleIColumn("clusterID");
+  analysisManager->CreateNtupleIColumn("size");
+  analysisManager->CreateNtupleFColumn("energy");
+  analysisManager->CreateNtupleFColumn("x");
+  analysisManager->CreateNtupleFColumn("y");
+  analysisManager->CreateNtupleFColumn("z");
+  analysisManager->FinishNtuple();
+
+  BookHistograms();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::BookHistograms()
+{
+  // Histograms of the histograms output format, filled by the stepping and
+  // tracking actions instead of the step and track ntuples.
+  // The binning can be changed from the macro with /analysis/h1/set
+  auto analysisManager = G4AnalysisManager::Instance();
+
+  // 0: process flags (one bin per flag)
+  analysisManager->CreateH1("flagProcess", "process flag of the steps", 801, -0.5, 800.5);
+
+  // 1, 2: kinetic energy of the created electron and gamma tracks
+  analysisManager->CreateH1("electronKineticEnergy", "electron track kinetic energy (eV)", 200,
+                            0., 2 * keV, "eV");
+  analysisManager->CreateH1("gammaKineticEnergy", "gamma track kinetic energy (eV)", 200, 0.,
+                            2 * keV, "eV");
+
+  // 3: cos of the scattering angle of the first step of the primary
+  analysisManager->CreateH1("cosTheta", "cosTheta of the first primary step", 200, -1., 1.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+// Elapsed time since the start of the program, in seconds
+const auto kProgramStart = std::chrono::steady_clock::now();
+
+G4double ElapsedTime()
+{
+  return std::chrono::duration<G4double>(std::chrono::steady_clock::now() - kProgramStart).count();
+}
+
+// One directory per table and thread, e.g. dna.columns/step_t0, with the
+// attempt of a resumed run, e.g. dna.columns/step_r1_t0 (see Checkpoint)
+G4String ColumnTableDirectory(const G4String& fileName, const G4String& table,
+                              const G4String& tag)
+{
+  G4String directory = fileName + ".columns/" + table + tag;
+  if (G4Threading::IsMultithreadedApplication()) {
+    directory += "_t" + std::to_string(G4Threading::G4GetThreadId());
+  }
+  return directory;
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::OpenColumns(const G4String& fileName)
+{
+  ColumnType value = fCompactSchema ? kColumnFloat32 : kColumnFloat64;
+
+  const G4String& tag = fCheckpoint.GetShardTag();
+  fStepWriter.Open(ColumnTableDirectory(fileName, "step", tag));
+  fStepWriter.AddColumn("flagParticle", kColumnInt32);
+  fStepWriter.AddColumn("flagProcess", kColumnInt32);
+  fStepWriter.AddColumn("x", value);
+  fStepWriter.AddColumn("y", value);
+  fStepWriter.AddColumn("z", value);
+  fStepWriter.AddColumn("totalEnergyDeposit", value);
+  fStepWriter.AddColumn("stepLength", value);
+  fStepWriter.AddColumn("kineticEnergyDifference", value);
+  fStepWriter.AddColumn("kineticEnergy", value);
+  fStepWriter.AddColumn("cosTheta", value);
+  fStepWriter.AddColumn("eventID", kColumnInt32);
+  fStepWriter.AddColumn("trackID", kColumnInt32);
+  fStepWriter.AddColumn("parentID", kColumnInt32);
+  fStepWriter.AddColumn("stepID", kColumnInt32);
+  fStepWriter.AddColumn("weight", value);
+
+  fTrackWriter.Open(ColumnTableDirectory(fileName, "track", tag));
+  fTrackWriter.AddColumn("flagParticle", kColumnInt32);
+  fTrackWriter.AddColumn("x", value);
+  fTrackWriter.AddColumn("y", value);
+  fTrackWriter.AddColumn("z", value);
+  fTrackWriter.AddColumn("dirx", value);
+  fTrackWriter.AddColumn("diry", value);
+  fTrackWriter.AddColumn("dirz", value);
+  fTrackWriter.AddColumn("kineticEnergy", value);
+  fTrackWriter.AddColumn("trackID", kColumnInt32);
+  fTrackWriter.AddColumn("parentID", kColumnInt32);
+
+  if (fDamageClusterer.IsActive()) {
+    fClusterWriter.Open(ColumnTableDirectory(fileName, "cluster", tag));
+    fClusterWriter.AddColumn("eventID", kColumnInt32);
+    fClusterWriter.AddColumn("clusterID", kColumnInt32);
+    fClusterWriter.AddColumn("size", kColumnInt32);
+    fClusterWriter.AddColumn("energy", kColumnFloat32);
+    fClusterWriter.AddColumn("x", kColumnFloat32);
+    fClusterWriter.AddColumn("y", kColumnFloat32);
+    fClusterWriter.AddColumn("z", kColumnFloat32);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::WriteTrack(const TrackRecord& track)
+{
+  if (fColumnarOutput) {
+    fTrackWriter.Write(0, &track.flagParticle, 1);
+    fTrackWriter.Write(1, &track.x, 1);
+    fTrackWriter.Write(2, &track.y, 1);
+    fTrackWriter.Write(3, &track.z, 1);
+    fTrackWriter.Write(4, &track.dirx, 1);
+    fTrackWriter.Write(5, &track.diry, 1);
+    fTrackWriter.Write(6, &track.dirz, 1);
+    fTrackWriter.Write(7, &track.kineticEnergy, 1);
+    fTrackWriter.Write(8, &track.trackID, 1);
+    fTrackWriter.Write(9, &track.parentID, 1);
+    return;
+  }
+
+  // Fill track information ntuple
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  analysisManager->FillNtupleDColumn(1, 0, track.flagParticle);
+  analysisManager->FillNtupleDColumn(1, 1, track.x);
+  analysisManager->FillNtupleDColumn(1, 2, track.y);
+  analysisManager->FillNtupleDColumn(1, 3, track.z);
+  analysisManager->FillNtupleDColumn(1, 4, track.dirx);
+  analysisManager->FillNtupleDColumn(1, 5, track.diry);
+  analysisManager->FillNtupleDColumn(1, 6, track.dirz);
+  analysisManager->FillNtupleDColumn(1, 7, track.kineticEnergy);
+  analysisManager->FillNtupleIColumn(1, 8, track.trackID);
+  analysisManager->FillNtupleIColumn(1, 9, track.parentID);
+  analysisManager->AddNtupleRow(1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::WriteHeldEvents()
+{
+  // Events kept by the reservoir sampling, in event order
+  fEventSampler.SortHeldEvents();
+  for (std::size_t i = 0; i < fEventSampler.GetNumberOfHeldEvents(); ++i) {
+    fEventSampler.SwapHeldSteps(i, fStepBuffer);
+    fStepBuffer.Flush();
+    for (const auto& track : fEventSampler.GetHeldTracks(i)) {
+      WriteTrack(track);
+    }
+  }
+  fEventSampler.ClearHeldEvents();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::WriteCheckpoint()
+{
+  // Rows of the events completed so far by this thread
+  fStepBuffer.Flush();
+  fStepWriter.Flush();
+  fTrackWriter.Flush();
+  fClusterWriter.Flush();
+  WriteMeta("dna", fCheckpoint.GetNumberOfEvents());
+  fCheckpoint.Write(fStepWriter.GetRows(), fTrackWriter.GetRows(), fClusterWriter.GetRows());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::WriteMeta(const G4String& fileName, G4int nofEvents)
+{
+  G4int schemaVersion = GetSchemaVersion();
+  G4int threadID = G4Threading::G4GetThreadId();
+
+  ColumnWriter metaWriter;
+  metaWriter.Open(ColumnTableDirectory(fileName, "meta", fCheckpoint.GetShardTag()));
+  metaWriter.AddColumn("schemaVersion", kColumnInt32);
+  metaWriter.AddColumn("threadID", kColumnInt32);
+  metaWriter.AddColumn("numberOfEvents", kColumnInt32);
+  metaWriter.AddColumn("samplingMode", kColumnInt32);
+  metaWriter.AddColumn("samplingFactor", kColumnFloat64);
+  metaWriter.AddColumn("recordedEvents", kColumnInt32);
+
+  G4int samplingMode = fEventSampler.GetMode();
+  G4double samplingFactor = fEventSampler.GetSamplingFactor();
+  G4int recordedEvents = fEventSampler.GetNumberOfRecordedEvents();
+  metaWriter.Write(0, &schemaVersion, 1);
+  metaWriter.Write(1, &threadID, 1);
+  metaWriter.Write(2, &nofEvents, 1);
+  metaWriter.Write(3, &samplingMode, 1);
+  metaWriter.Write(4, &samplingFactor, 1);
+  metaWriter.Write(5, &recordedEvents, 1);
+  metaWriter.Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::CloseColumns(const G4String& fileName, G4int nofEvents)
+{
+  WriteMeta(fileName, nofEvents);
+
+  fStepWriter.Close();
+  fTrackWriter.Close();
+  fClusterWriter.Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::WriteManifest(const G4String& fileName, const G4Run* aRun)
+{
+  // Describes the per-thread output shards for the dnamerge tool
+  const Run* run = static_cast<const Run*>(aRun);
+
+  std::ofstream manifest(fileName + ".manifest");
+  manifest << "# dnaphysics output shards" << '\n';
+  manifest << "name " << fileName << '\n';
+  manifest << "format " << (fColumnarOutput ? "columnar" : "root") << '\n';
+  manifest << "schema " << GetSchemaVersion() << '\n';
+  manifest << "events "
+           << aRun->GetNumberOfEvent() - run->GetNumberOfSkippedEvents()
+                + fCheckpoint.GetNumberOfRecoveredEvents()
+           << '\n';
+  manifest << "sampling " << fEventSampler.GetModeName() << ' ' << fEventSampler.GetValue()
+           << '\n';
+
+  // Shards of this run, named after the attempt when it is resumed
+  const G4String& tag = fCheckpoint.GetShardTag();
+  if (G4Threading::IsMultithreadedApplication()) {
+    for (const auto& shard : run->GetShards()) {
+      if (shard.numberOfEvents == 0) continue;
+      manifest << "shard " << shard.threadID << ' ' << shard.numberOfEvents << ' ' << tag
+               << "_t" << shard.threadID << '\n';
+    }
+  }
+  else if (aRun->GetNumberOfEvent() > run->GetNumberOfSkippedEvents()) {
+    manifest << "shard 0 " << aRun->GetNumberOfEvent() - run->GetNumberOfSkippedEvents() << ' '
+             << tag << '\n';
+  }
+
+  // Shards of the interrupted attempts
+  for (const auto& shard : fCheckpoint.GetRecoveredShards()) {
+    if (shard.events.empty()) continue;
+    manifest << "shard " << shard.threadID << ' ' << shard.events.size() << ' ' << shard.suffix
+             << '\n';
+  }
+
+  // Histograms and meta ntuple of the master, merged together with the shards
+  if (!fColumnarOutput && G4Threading::IsMultithreadedApplication()) {
+    manifest << "master " << fileName << ".root" << '\n';
+  }
+
+  G4cout << "--- Output shards listed in " << fileName << ".manifest" << G4endl;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-RunAction::~RunAction() {}
+void RunAction::PrintLoadBalance(const G4Run* aRun, G4double runTime) const
+{
+  // Idle time: part of the run during which a thread processed no event
+  // (waiting for tasks, or done before the slowest thread)
+  const Run* run = static_cast<const Run*>(aRun);
+
+  G4cout << "--- Load balance (" << runTime << " s run):" << G4endl;
+  G4double totalIdle = 0.;
+  for (const auto& shard : run->GetShards()) {
+    G4double idle = std::max(0., runTime - shard.busyTime);
+    totalIdle += idle;
+    G4cout << "    thread " << shard.threadID << ": " << shard.numberOfEvents << " events, busy "
+           << shard.busyTime << " s, idle " << idle << " s";
+    if (runTime > 0.) G4cout << " (" << 100. * shard.busyTime / runTime << "% busy)";
+    G4cout << G4endl;
+  }
+  std::size_t nThreads = run->GetShards().size();
+  if (nThreads > 0 && runTime > 0.) {
+    G4cout << "    average idle fraction: " << 100. * totalIdle / (nThreads * runTime) << "%"
+           << G4endl;
+  }
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void RunAction::BeginOfRunAction(const G4Run*)
+G4Run* RunAction::GenerateRun()
 {
+  auto run = new Run;
+
+  // Same binning on all threads, set from /dna/micro/binsPerDecade
+  run->GetLinealEnergySpectrum().SetBinning(0.01, 1.e4,
+                                            fMicrodosimetryScorer.GetBinsPerDecade());
+
+  auto detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
+  // Radial bins from 0.1 nm to the world size
+  if (fRadialDoseScorer.IsActive()) {
+    run->GetRadialDoseProfile().SetBinning(0.1 * nm, detector->GetSize(),
+                                           fRadialDoseScorer.GetBinsPerDecade());
+  }
+
+  // The dose mesh covers the world volume
+  if (fDoseMeshActive) {
+    run->GetDoseMesh().Configure(detector->GetSize(), fVoxelSize, fSparseDoseMesh);
+  }
+
+  if (fProfileActive) run->GetProcessProfile().Configure();
+  return run;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::BeginOfRunAction(const G4Run* aRun)
+{
+  // Initialization (geometry, physics tables) happens before the first run
+  fRunStartTime = ElapsedTime();
+  if (fInitializationTime < 0.) fInitializationTime = fRunStartTime;
+
+  auto run = static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+  fRun = run;
+
+  // Particle and process flags used by the tracking and stepping actions
+  fStepClassifier.Build();
+
+  // Recorded steps, from the /step/filter/ rules
+  // (the commands are broadcast to the workers, which own the filters)
+  fStepFilter.Compile();
+  if (G4Threading::G4GetThreadId() == 0 || !G4Threading::IsMultithreadedApplication()) {
+    fStepFilter.Print();
+  }
+
+  fDoseMesh = fDoseMeshActive ? &run->GetDoseMesh() : nullptr;
+  fProcessProfile = fProfileActive ? &run->GetProcessProfile() : nullptr;
+
+  // The event-by-event scorers ignore the weights of /dna/mi/bias
+  auto physicsList =
+    dynamic_cast<const PhysicsList*>(G4RunManagerKernel::GetRunManagerKernel()->GetPhysicsList());
+  G4bool biased = physicsList != nullptr && physicsList->IsMultipleIonisationBiased();
+  if (biased && IsMaster()
+      && (fMicrodosimetryScorer.IsActive() || fDamageClusterer.IsActive()))
+  {
+    G4Exception("RunAction::BeginOfRunAction()", "dnaphysics015", JustWarning,
+                "The lineal energy and clustering scorers are filled with the unweighted "
+                "deposits of the biased multiple ionisations.");
+  }
+
+  // Tracked first steps follow the enhanced cross sections: their distances
+  // and processes cannot be reweighted (the stepping actions are on the
+  // workers; the direct sampling corrects its own weights)
+  auto steppingAction =
+    static_cast<const SteppingAction*>(G4RunManager::GetRunManager()->GetUserSteppingAction());
+  if (biased && steppingAction != nullptr && steppingAction->GetKillStatus() != 0
+      && !fFirstInteractionSampler.IsActive()
+      && (G4Threading::G4GetThreadId() == 0 || !G4Threading::IsMultithreadedApplication()))
+  {
+    G4Exception("RunAction::BeginOfRunAction()", "dnaphysics016", JustWarning,
+                "/step/recordOnlyFirstStep with /dna/mi/bias: the first steps are biased "
+                "towards the multiple ionisations; use the direct sampling (/dna/direct/) "
+                "for weighted first interactions.");
+  }
+
+  BookNtuples();
+  fStepBuffer.SetCompactSchema(fCompactSchema);
+  fStepBuffer.ResetStatistics();
+
+  // Events and steps recorded, from /dna/output/sampling
+  // (histograms are always filled with every step)
+  fEventSampler.BeginOfRun();
+  fStepBuffer.SetHold(fEventSampler.IsHoldingEvents() && !fHistogramOutput);
+
+  // Events of this process in a sharded run, then seeding and shard names of
+  // a checkpointed (or resumed) run
+  fShardSelection.BeginOfRun(aRun);
+  fCheckpoint.BeginOfRun(aRun);
+
+  // The lineal energy and radial dose files hold normalised distributions,
+  // which cannot be summed over the processes of a sharded run (the dose
+  // meshes are, see ShardLauncher)
+  if (fShardSelection.IsActive() && IsMaster()
+      && (fMicrodosimetryScorer.IsActive() || fRadialDoseScorer.IsActive()))
+  {
+    G4Exception("RunAction::BeginOfRunAction()", "dnaphysics017", FatalException,
+                "The lineal energy (/dna/micro/) and radial dose (/dna/radial/) scorers are "
+                "not available in a sharded run (--shards); run the macro in one process.");
+  }
+
+  G4String fileName = "dna";
+
+  if (fColumnarOutput) {
+    // Worker threads write their own tables; the master has no data
+    fStepBuffer.SetColumnWriter(&fStepWriter);
+    fDamageClusterer.SetColumnWriter(fDamageClusterer.IsActive() ? &fClusterWriter : nullptr);
+    if (!IsMaster() || !G4Threading::IsMultithreadedApplication()) {
+      OpenColumns(fileName);
+    }
+    return;
+  }
+  fStepBuffer.SetColumnWriter(nullptr);
+  fDamageClusterer.SetColumnWriter(nullptr);
+
   auto analysisManager = G4AnalysisManager::Instance();
 
+  // Without merging each worker writes its own dna_tN.root shard
+  analysisManager->SetNtupleMerging(fNtupleMerging);
+
+  // The histograms format writes the histograms and the meta ntuple only
+  analysisManager->SetActivation(true);
+  for (G4int id = 0; id < 4; ++id) {
+    analysisManager->SetH1Activation(id, fHistogramOutput);
+  }
+  analysisManager->SetNtupleActivation(0, !fHistogramOutput);
+  analysisManager->SetNtupleActivation(1, !fHistogramOutput);
+  analysisManager->SetNtupleActivation(3, fDamageClusterer.IsActive());
+
   // Open an output file
-  G4String fileName = "dna";
   analysisManager->OpenFile(fileName);
 }
 
@@ -111,13 +615,168 @@ void RunAction::BeginOfRunAction(const G4Run*)
 
 void RunAction::EndOfRunAction(const G4Run* aRun)
 {
-  G4int nofEvents = aRun->GetNumberOfEvent();
-  if (nofEvents == 0) return;
+  // Physics tables of a new configuration, for the next starts
+  if (IsMaster()) {
+    auto physicsList =
+      dynamic_cast<PhysicsList*>(G4RunManagerKernel::GetRunManagerKernel()->GetPhysicsList());
+    if (physicsList != nullptr) physicsList->StoreTableCache();
+  }
 
-  // Print histogram statistics
-  auto analysisManager = G4AnalysisManager::Instance();
+  if (aRun->GetNumberOfEvent() == 0) {
+    fCheckpoint.EndOfRun(aRun);
+    fShardSelection.EndOfRun(aRun);
+    return;
+  }
+
+  // Without the events skipped by a resumed run (see Checkpoint)
+  G4int nofEvents =
+    aRun->GetNumberOfEvent() - static_cast<const Run*>(aRun)->GetNumberOfSkippedEvents();
+
+  // Steps still buffered, if any
+  fStepBuffer.Flush();
+  if (fEventSampler.IsHoldingEvents() && !fHistogramOutput) WriteHeldEvents();
+
+  G4bool worker = !IsMaster() || !G4Threading::IsMultithreadedApplication();
+  auto start = std::chrono::steady_clock::now();
+  std::size_t bytes = 0;
+
+  if (fColumnarOutput) {
+    if (worker) {
+      bytes = fStepWriter.GetBytesWritten() + fTrackWriter.GetBytesWritten();
+      if (fCheckpoint.IsActive()) WriteCheckpoint();
+      CloseColumns("dna", nofEvents);
+    }
+  }
+  else {
+    // Print histogram statistics
+    auto analysisManager = G4AnalysisManager::Instance();
+
+    // Record the schema with the data written by this thread
+    if (worker) {
+      analysisManager->FillNtupleIColumn(2, 0, GetSchemaVersion());
+      analysisManager->FillNtupleIColumn(2, 1, G4Threading::G4GetThreadId());
+      analysisManager->FillNtupleIColumn(2, 2, nofEvents);
+      analysisManager->FillNtupleIColumn(2, 3, fEventSampler.GetMode());
+      analysisManager->FillNtupleDColumn(2, 4, fEventSampler.GetSamplingFactor());
+      analysisManager->FillNtupleIColumn(2, 5, fEventSampler.GetNumberOfRecordedEvents());
+      analysisManager->AddNtupleRow(2);
+    }
+
+    // Save histograms
+    analysisManager->Write();
+    analysisManager->CloseFile();
+  }
+
+  std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - start;
+
+  // Time spent in the output backend, for comparing the formats
+  if (worker) {
+    G4cout << "--- Output (" << GetOutputFormat() << "): "
+           << fStepBuffer.GetRowsWritten() << " step rows, "
+           << fStepBuffer.GetWriteTime() << " s filling, " << elapsed.count()
+           << " s writing/closing";
+    if (fColumnarOutput) G4cout << ", " << bytes << " bytes";
+    if (fEventSampler.GetMode() != EventSampler::kSampleAll) {
+      G4cout << ", sampling " << fEventSampler.GetModeName() << ' ' << fEventSampler.GetValue()
+             << " (" << fEventSampler.GetNumberOfRecordedEvents() << '/'
+             << fEventSampler.GetNumberOfEvents() << " events)";
+    }
+    G4cout << G4endl;
+  }
+
+  // Lineal energy spectrum, merged from all threads
+  G4bool master = IsMaster() || !G4Threading::IsMultithreadedApplication();
+  if (fMicrodosimetryScorer.IsActive() && master) {
+    const auto& spectrum = static_cast<const Run*>(aRun)->GetLinealEnergySpectrum();
+    spectrum.Write("dna.lineal", fMicrodosimetryScorer.GetDescription());
+    G4cout << "--- Lineal energy (" << fMicrodosimetryScorer.GetDescription() << "):" << G4endl
+           << "    yF = " << spectrum.GetFrequencyMean()
+           << " keV/um, yD = " << spectrum.GetDoseMean() << " keV/um (written to dna.lineal)"
+           << G4endl;
+  }
+
+  auto detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
+  if (fRadialDoseScorer.IsActive() && master) {
+    const auto& profile = static_cast<const Run*>(aRun)->GetRadialDoseProfile();
+    profile.Write("dna.radial", detector->GetMaterial()->GetDensity());
+    G4cout << "--- Radial dose profile around the primary path written to dna.radial"
+           << G4endl;
+  }
+
+  if (fDoseMeshActive && master) {
+    const auto& mesh = static_cast<const Run*>(aRun)->GetDoseMesh();
+    mesh.Write("dna.dose", detector->GetMaterial()->GetDensity());
+    G4cout << "--- Dose mesh: " << mesh.GetNumberOfFilledVoxels() << " of "
+           << mesh.GetNumberOfVoxels() << " voxels filled (written to dna.dose)" << G4endl;
+  }
+
+  if (fDamageClusterer.IsActive() && master) {
+    auto run = static_cast<const Run*>(aRun);
+    G4cout << "--- DBSCAN: " << run->GetNumberOfClusters() << " clusters, "
+           << run->GetNumberOfNoisePoints() << " isolated points" << G4endl;
+  }
+
+  if (fProfileActive && master) {
+    const auto& profile = static_cast<const Run*>(aRun)->GetProcessProfile();
+    profile.Print();
+    if (!fProfileJsonFile.empty()) {
+      profile.WriteJson(fProfileJsonFile);
+      G4cout << "    (written to " << fProfileJsonFile << ")" << G4endl;
+    }
+  }
+
+  // Rate of primaries, for comparing the direct sampling of the first
+  // interaction with the full tracking
+  if (master) {
+    G4double seconds = ElapsedTime() - fRunStartTime;
+    G4long primaries = nofEvents;
+    G4String mode = "full tracking";
+    if (fFirstInteractionSampler.IsActive()) {
+      primaries = static_cast<const Run*>(aRun)->GetNumberOfFirstInteractions();
+      mode = "direct first interaction";
+    }
+    G4cout << "--- Primaries (" << mode << "): " << primaries << " in " << seconds << " s";
+    if (seconds > 0.) G4cout << ", " << primaries / seconds << " /s";
+    G4cout << G4endl;
+
+    // Weighted yields of the multiple ionisations (see /dna/mi/bias), with
+    // their relative statistical error
+    auto run = static_cast<const Run*>(aRun);
+    G4double multipleIonisations = 0.;
+    for (G4int m = 2; m <= 4; ++m) {
+      multipleIonisations += run->GetMultipleIonisations(m);
+    }
+    if (multipleIonisations > 0. && primaries > 0) {
+      static const char* const names[3] = {"double", "triple", "quadruple"};
+      G4cout << "--- Multiple ionisations per primary:";
+      for (G4int m = 2; m <= 4; ++m) {
+        G4double sum = run->GetMultipleIonisations(m);
+        G4cout << ' ' << names[m - 2] << ' ' << sum / primaries;
+        if (sum > 0.) {
+          G4cout << " (" << 100. * std::sqrt(run->GetMultipleIonisations2(m)) / sum << "%)";
+        }
+      }
+      G4cout << G4endl;
+    }
+
+    // Parsed by dnaphysics_bench
+    G4cout << "--- Run: events " << nofEvents << " steps "
+           << static_cast<const Run*>(aRun)->GetNumberOfSteps() << " init "
+           << fInitializationTime << " s run " << seconds << " s" << G4endl;
+
+    if (G4Threading::IsMultithreadedApplication()) PrintLoadBalance(aRun, seconds);
+  }
+
+  // Shards are left to be merged offline (dnamerge)
+  if (IsMaster()
+      && ((G4Threading::IsMultithreadedApplication() && (fColumnarOutput || !fNtupleMerging))
+          || fCheckpoint.IsActive()))
+  {
+    WriteManifest("dna", aRun);
+  }
 
-  // Save histograms
-  analysisManager->Write();
-  analysisManager->CloseFile();
+  fCheckpoint.EndOfRun(aRun);
+  fShardSelection.EndOfRun(aRun);
 }
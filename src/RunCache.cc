@@ -0,0 +1,346 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file RunCache.cc
+/// \brief Implementation of the RunCache class
+
+#include "RunCache.hh"
+#include "RunCacheMessenger.hh"
+
+#include "DetectorConstruction.hh"
+#include "OutputShards.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "RunAction.hh"
+
+#include "G4Material.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleGun.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4UImanager.hh"
+#include "G4Version.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+// Commands kept in the history of the master, for the key
+const G4int kMaxHistory = 100000;
+
+// Commands that do not change the output
+const char* const kIgnoredCommands[] = {
+  "/control/",         "/vis/",           "/dna/cache/",
+  "/run/beamOn",       "/run/verbose",    "/run/printProgress",
+  "/run/numberOfThreads", "/run/eventModulo", "/event/verbose",
+  "/tracking/verbose", "/process/verbose", "/process/em/verbose",
+  "/dna/checkpoint/resume", "/dna/test/scan/",
+  // Their current values are in the key (gun and material lines), so that
+  // the earlier points of a scan do not change the key of the next ones
+  "/gun/particle",     "/gun/energy",     "/dna/test/setMatDens"};
+
+fs::path SegmentPath(const std::string& directory, G4int index)
+{
+  return fs::path(directory) / ("seg" + std::to_string(index));
+}
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunCache::RunCache(RunAction* runAction) : fRunAction(runAction)
+{
+  fMessenger = new RunCacheMessenger(this);
+
+  // The key is made on the master, from its history of commands
+  if (G4Threading::IsMasterThread()) {
+    G4UImanager::GetUIpointer()->SetMaxHistSize(kMaxHistory);
+    if (G4Threading::IsMultithreadedApplication()) fGun = new G4ParticleGun(1);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunCache::~RunCache()
+{
+  delete fGun;
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::string RunCache::GetConfiguration() const
+{
+  std::ostringstream configuration;
+  configuration << std::setprecision(12);
+  configuration << "geant4 " << G4VERSION_NUMBER << '\n';
+  configuration << "seed " << G4Random::getTheSeed() << '\n';
+
+  auto runManager = G4RunManager::GetRunManager();
+  auto detector =
+    static_cast<const DetectorConstruction*>(runManager->GetUserDetectorConstruction());
+  configuration << "material " << detector->GetMaterial()->GetName() << ' '
+                << detector->GetMaterial()->GetDensity() / (g / cm3) << " g/cm3\n";
+  configuration << "world " << detector->GetSize() / nm << " nm\n";
+
+  // Gun of this thread in sequential mode, or its copy on the master
+  const G4ParticleGun* gun = fGun;
+  if (gun == nullptr) {
+    auto generator =
+      dynamic_cast<const PrimaryGeneratorAction*>(runManager->GetUserPrimaryGeneratorAction());
+    if (generator != nullptr) gun = generator->GetParticleGun();
+  }
+  if (gun != nullptr && gun->GetParticleDefinition() != nullptr) {
+    configuration << "gun " << gun->GetParticleDefinition()->GetParticleName() << ' '
+                  << gun->GetParticleEnergy() / eV << " eV " << gun->GetParticlePosition() / nm
+                  << " nm " << gun->GetParticleMomentumDirection() << '\n';
+  }
+
+  auto UImanager = G4UImanager::GetUIpointer();
+  for (G4int i = 0; i < UImanager->GetNumberOfHistory(); ++i) {
+    G4String command = UImanager->GetPreviousCommand(i);
+    G4bool ignored = false;
+    for (const char* prefix : kIgnoredCommands) {
+      if (command.rfind(prefix, 0) == 0) ignored = true;
+    }
+    if (!ignored) configuration << command << '\n';
+  }
+  return configuration.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::string RunCache::GetKey() const
+{
+  // FNV-1a
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (unsigned char c : GetConfiguration()) {
+    hash = (hash ^ c) * 0x100000001b3ULL;
+  }
+  std::ostringstream key;
+  key << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunCache::SetEventSeeding(const G4String& key, G4int firstEvent)
+{
+  EventSeeder& seeder = fRunAction->GetEventSeeder();
+  if (key == "none") {
+    seeder.Reset();
+    return;
+  }
+  seeder.SetSeed(std::strtoull(key.c_str(), nullptr, 16) | 1);
+  seeder.SetFirstEvent(firstEvent);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<RunCache::Segment> RunCache::ReadSegments(const std::string& directory) const
+{
+  std::vector<Segment> segments;
+  std::ifstream file(directory + "/segments");
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream tokens(line);
+    std::string key;
+    Segment segment;
+    tokens >> key >> segment.index >> segment.firstEvent >> segment.events;
+    if (key == "segment" && !tokens.fail()) segments.push_back(segment);
+  }
+  return segments;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunCache::WriteSegments(const std::string& directory,
+                             const std::vector<Segment>& segments) const
+{
+  std::ofstream file(directory + "/segments");
+  file << "# segment index firstEvent events" << '\n';
+  for (const auto& segment : segments) {
+    file << "segment " << segment.index << ' ' << segment.firstEvent << ' ' << segment.events
+         << '\n';
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool RunCache::Store(const std::string& directory, const Segment& segment) const
+{
+  try {
+    fs::path path = SegmentPath(directory, segment.index);
+    fs::remove_all(path);
+    fs::create_directories(path);
+    for (const auto& entry : fs::directory_iterator(".")) {
+      fs::path name = entry.path().filename();
+      if (OutputShards::IsOutput(name.string())) {
+        fs::copy(entry.path(), path / name, fs::copy_options::recursive);
+      }
+    }
+    std::ofstream(directory + "/configuration") << GetConfiguration();
+  }
+  catch (const fs::filesystem_error& error) {
+    G4ExceptionDescription description;
+    description << "Cannot store the run in " << directory << ": " << error.what();
+    G4Exception("RunCache::Store()", "dnaphysics008", JustWarning, description);
+    return false;
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool RunCache::Restore(const std::string& directory,
+                         const std::vector<Segment>& segments) const
+{
+  try {
+    OutputShards::RemoveOutputs();
+
+    // The output of a single run is copied as is
+    if (segments.size() == 1) {
+      for (const auto& entry : fs::directory_iterator(SegmentPath(directory, segments[0].index))) {
+        fs::copy(entry.path(), entry.path().filename(), fs::copy_options::recursive);
+      }
+      return true;
+    }
+
+    // Otherwise the shards of segment k are renamed dna_ck..., e.g.
+    // dna_c1.root, dna_c1_t3.root or dna.columns/step_c1_t3
+    OutputShards shards;
+    for (std::size_t k = 0; k < segments.size(); ++k) {
+      shards.Add(SegmentPath(directory, segments[k].index).string(), "_c" + std::to_string(k),
+                 segments[k].events);
+    }
+    shards.Combine(false, "cached runs");
+  }
+  catch (const fs::filesystem_error& error) {
+    G4ExceptionDescription description;
+    description << "Cannot restore the run from " << directory << ": " << error.what();
+    G4Exception("RunCache::Restore()", "dnaphysics008", JustWarning, description);
+    return false;
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunCache::BeamOn(G4int nofEvents)
+{
+  std::string key = GetKey();
+  std::string directory = fDirectory + "/" + key;
+  std::vector<Segment> segments = ReadSegments(directory);
+
+  // Segments of the first events, up to nofEvents
+  std::vector<Segment> cached;
+  G4int nofCached = 0;
+  for (const auto& segment : segments) {
+    if (nofCached + segment.events > nofEvents) break;
+    cached.push_back(segment);
+    nofCached += segment.events;
+  }
+
+  G4bool restored = (nofCached == nofEvents) && Restore(directory, cached);
+  if (restored) {
+    G4cout << "--- Run cache: " << nofEvents << " events restored from " << directory;
+    if (cached.size() > 1) G4cout << " (" << cached.size() << " runs listed in dna.manifest)";
+    G4cout << G4endl;
+    return;
+  }
+
+  G4bool store = true;
+  G4int firstEvent = 0;
+  if (nofCached == nofEvents || cached.size() < segments.size()) {
+    // The restore failed, or more events are cached but not at a run boundary
+    store = false;
+  }
+  else if (nofCached > 0 && fRunAction->HasRunOutput()) {
+    // Spectra, profiles, mesh and reservoirs are made for the whole run and
+    // cannot be extended: the run is done again
+    G4cout << "--- Run cache: the output of " << directory
+           << " covers a whole run; running the " << nofEvents << " events again" << G4endl;
+    std::error_code error;
+    fs::remove_all(directory, error);
+    segments.clear();
+  }
+  else if (nofCached > 0) {
+    firstEvent = nofCached;
+    G4cout << "--- Run cache: " << nofCached << " events cached in " << directory
+           << ", running events " << firstEvent << " to " << nofEvents - 1 << G4endl;
+  }
+
+  OutputShards::RemoveOutputs();
+  auto UImanager = G4UImanager::GetUIpointer();
+  UImanager->ApplyCommand("/dna/cache/eventSeeding " + key + " " + std::to_string(firstEvent));
+  auto runManager = G4RunManager::GetRunManager();
+  runManager->BeamOn(nofEvents - firstEvent);
+  UImanager->ApplyCommand("/dna/cache/eventSeeding none");
+
+  // Aborted runs are not stored
+  const G4Run* run = runManager->GetCurrentRun();
+  if (run == nullptr || run->GetNumberOfEvent() != nofEvents - firstEvent) return;
+  if (!store) {
+    G4cout << "--- Run cache: the run is not stored in " << directory << G4endl;
+    return;
+  }
+
+  Segment segment;
+  segment.index = segments.empty() ? 0 : segments.back().index + 1;
+  segment.firstEvent = firstEvent;
+  segment.events = nofEvents - firstEvent;
+  if (!Store(directory, segment)) return;
+  segments.push_back(segment);
+  WriteSegments(directory, segments);
+  G4cout << "--- Run cache: events " << firstEvent << " to " << nofEvents - 1 << " stored in "
+         << directory << G4endl;
+
+  // Output of all the events
+  if (segments.size() > 1 && Restore(directory, segments)) {
+    G4cout << "--- Run cache: " << nofEvents << " events in " << segments.size()
+           << " runs listed in dna.manifest (merged with dnamerge)" << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
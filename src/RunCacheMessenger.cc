@@ -0,0 +1,119 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file RunCacheMessenger.cc
+/// \brief Implementation of the RunCacheMessenger class
+
+#include "RunCacheMessenger.hh"
+#include "RunCache.hh"
+
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunCacheMessenger::RunCacheMessenger(RunCache* cache) : fCache(cache)
+{
+  fCacheDir = new G4UIdirectory("/dna/cache/");
+  fCacheDir->SetGuidance("cache of the run output, keyed on the configuration");
+
+  fDirectoryCmd = new G4UIcmdWithAString("/dna/cache/directory", this);
+  fDirectoryCmd->SetGuidance("Directory of the cached runs (default dna.cache).");
+  fDirectoryCmd->SetParameterName("directory", false);
+  fDirectoryCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fDirectoryCmd->SetToBeBroadcasted(false);
+
+  fBeamOnCmd = new G4UIcmdWithAnInteger("/dna/cache/beamOn", this);
+  fBeamOnCmd->SetGuidance("Same as /run/beamOn, with the output taken from the cache");
+  fBeamOnCmd->SetGuidance("when the configuration has already been run:");
+  fBeamOnCmd->SetGuidance(" - with N events: the output is restored, nothing is run;");
+  fBeamOnCmd->SetGuidance(" - with less events: only the missing events are run, and");
+  fBeamOnCmd->SetGuidance("   dna.manifest lists the parts of the output for dnamerge.");
+  fBeamOnCmd->SetGuidance("The events are seeded from the configuration and their number.");
+  fBeamOnCmd->SetParameterName("events", false);
+  fBeamOnCmd->SetRange("events>0");
+  fBeamOnCmd->AvailableForStates(G4State_Idle);
+  fBeamOnCmd->SetToBeBroadcasted(false);
+
+  fEventSeedingCmd = new G4UIcommand("/dna/cache/eventSeeding", this);
+  fEventSeedingCmd->SetGuidance("Seeding of the events of a cached run (set by /dna/cache/beamOn).");
+  fEventSeedingCmd->SetGuidance("Each event is seeded from the key and its global event ID,");
+  fEventSeedingCmd->SetGuidance("the first event of the run plus its event ID; none: off.");
+  auto keyPrm = new G4UIparameter("key", 's', false);
+  fEventSeedingCmd->SetParameter(keyPrm);
+  auto firstPrm = new G4UIparameter("firstEvent", 'i', true);
+  firstPrm->SetDefaultValue(0);
+  firstPrm->SetParameterRange("firstEvent>=0");
+  fEventSeedingCmd->SetParameter(firstPrm);
+  fEventSeedingCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunCacheMessenger::~RunCacheMessenger()
+{
+  delete fDirectoryCmd;
+  delete fBeamOnCmd;
+  delete fEventSeedingCmd;
+  delete fCacheDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunCacheMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fDirectoryCmd) {
+    fCache->SetDirectory(newValue);
+  }
+
+  if (command == fBeamOnCmd) {
+    fCache->BeamOn(fBeamOnCmd->GetNewIntValue(newValue));
+  }
+
+  if (command == fEventSeedingCmd) {
+    G4String key;
+    G4int firstEvent = 0;
+    std::istringstream is(newValue);
+    is >> key >> firstEvent;
+    fCache->SetEventSeeding(key, firstEvent);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
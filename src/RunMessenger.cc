@@ -0,0 +1,224 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file RunMessenger.cc
+/// \brief Implementation of the RunMessenger class
+
+#include "RunMessenger.hh"
+#include "RunAction.hh"
+
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunMessenger::RunMessenger(RunAction* run) : fRunAction(run)
+{
+  fOutputDir = new G4UIdirectory("/dna/output/");
+  fOutputDir->SetGuidance("output control");
+
+  fSchemaCmd = new G4UIcmdWithAString("/dna/output/schema", this);
+  fSchemaCmd->SetGuidance("Select the column types of the step ntuple.");
+  fSchemaCmd->SetGuidance(" default: double flags and values, int IDs (schema 3)");
+  fSchemaCmd->SetGuidance(" compact: int flags and IDs, float nm/eV values (schema 4)");
+  fSchemaCmd->SetGuidance("Must be set before the first /run/beamOn.");
+  fSchemaCmd->SetParameterName("schema", false);
+  fSchemaCmd->SetCandidates("default compact");
+  fSchemaCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fFormatCmd = new G4UIcmdWithAString("/dna/output/format", this);
+  fFormatCmd->SetGuidance("Select the output of the step and track information.");
+  fFormatCmd->SetGuidance(" root: G4AnalysisManager ntuples in dna.root (default)");
+  fFormatCmd->SetGuidance(" columnar: fixed-width column files in dna.columns/");
+  fFormatCmd->SetGuidance(" histograms: histograms only in dna.root, no step/track rows");
+  fFormatCmd->SetParameterName("format", false);
+  fFormatCmd->SetCandidates("root columnar histograms");
+  fFormatCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fMergeCmd = new G4UIcmdWithABool("/dna/output/merge", this);
+  fMergeCmd->SetGuidance("Merge the worker ntuples into dna.root (default true).");
+  fMergeCmd->SetGuidance("If false, each worker writes its own dna_tN.root shard and");
+  fMergeCmd->SetGuidance("the master writes dna.manifest for the dnamerge tool.");
+  fMergeCmd->SetParameterName("merge", false);
+  fMergeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSamplingCmd = new G4UIcommand("/dna/output/sampling", this);
+  fSamplingCmd->SetGuidance("Record only a sample of the steps and tracks.");
+  fSamplingCmd->SetGuidance(" all: every event (default)");
+  fSamplingCmd->SetGuidance(" every N: the events with eventID % N == 0");
+  fSamplingCmd->SetGuidance(" reservoir K: K events per thread, uniformly chosen");
+  fSamplingCmd->SetGuidance(" steps f: a fraction f of the steps of each event");
+  fSamplingCmd->SetGuidance("The sampling is recorded in the meta ntuple.");
+  auto modePrm = new G4UIparameter("mode", 's', false);
+  modePrm->SetParameterCandidates("all every reservoir steps");
+  fSamplingCmd->SetParameter(modePrm);
+  auto valuePrm = new G4UIparameter("value", 'd', true);
+  valuePrm->SetDefaultValue(1.);
+  valuePrm->SetParameterRange("value>0.");
+  fSamplingCmd->SetParameter(valuePrm);
+  fSamplingCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSamplingSeedCmd = new G4UIcmdWithAnInteger("/dna/output/samplingSeed", this);
+  fSamplingSeedCmd->SetGuidance("Seed of the sampling random numbers (default 0).");
+  fSamplingSeedCmd->SetParameterName("seed", false);
+  fSamplingSeedCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fMeshDir = new G4UIdirectory("/dna/mesh/");
+  fMeshDir->SetGuidance("voxel dose mesh covering the world volume");
+
+  fMeshActiveCmd = new G4UIcmdWithABool("/dna/mesh/activate", this);
+  fMeshActiveCmd->SetGuidance("Score the dose in a voxel mesh (written to dna.dose).");
+  fMeshActiveCmd->SetParameterName("activate", true);
+  fMeshActiveCmd->SetDefaultValue(true);
+  fMeshActiveCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fVoxelSizeCmd = new G4UIcmdWithADoubleAndUnit("/dna/mesh/voxelSize", this);
+  fVoxelSizeCmd->SetGuidance("Size of the cubic voxels.");
+  fVoxelSizeCmd->SetParameterName("voxelSize", false);
+  fVoxelSizeCmd->SetRange("voxelSize>0.");
+  fVoxelSizeCmd->SetUnitCategory("Length");
+  fVoxelSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fStorageCmd = new G4UIcmdWithAString("/dna/mesh/storage", this);
+  fStorageCmd->SetGuidance("Storage of the voxels of each thread:");
+  fStorageCmd->SetGuidance(" sparse: voxels with a deposit only (default)");
+  fStorageCmd->SetGuidance(" dense: all voxels, 8 bytes each");
+  fStorageCmd->SetParameterName("storage", false);
+  fStorageCmd->SetCandidates("sparse dense");
+  fStorageCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fProfileDir = new G4UIdirectory("/dna/profile/");
+  fProfileDir->SetGuidance("steps, energy and time per particle and process");
+
+  fProfileActiveCmd = new G4UIcmdWithABool("/dna/profile/activate", this);
+  fProfileActiveCmd->SetGuidance("Count the steps, deposited energy and time per");
+  fProfileActiveCmd->SetGuidance("(particle, process) pair; printed at the end of the run.");
+  fProfileActiveCmd->SetParameterName("activate", true);
+  fProfileActiveCmd->SetDefaultValue(true);
+  fProfileActiveCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fProfilePeriodCmd = new G4UIcmdWithAnInteger("/dna/profile/samplingPeriod", this);
+  fProfilePeriodCmd->SetGuidance("Time one step out of N (default 16).");
+  fProfilePeriodCmd->SetParameterName("period", false);
+  fProfilePeriodCmd->SetRange("period>0");
+  fProfilePeriodCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fProfileJsonCmd = new G4UIcmdWithAString("/dna/profile/json", this);
+  fProfileJsonCmd->SetGuidance("Also write the profile to this JSON file.");
+  fProfileJsonCmd->SetParameterName("fileName", false);
+  fProfileJsonCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunMessenger::~RunMessenger()
+{
+  delete fSchemaCmd;
+  delete fFormatCmd;
+  delete fMergeCmd;
+  delete fSamplingCmd;
+  delete fSamplingSeedCmd;
+  delete fMeshActiveCmd;
+  delete fVoxelSizeCmd;
+  delete fStorageCmd;
+  delete fMeshDir;
+  delete fProfileActiveCmd;
+  delete fProfilePeriodCmd;
+  delete fProfileJsonCmd;
+  delete fProfileDir;
+  delete fOutputDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fSchemaCmd) {
+    fRunAction->SetCompactSchema(newValue == "compact");
+  }
+
+  if (command == fFormatCmd) {
+    fRunAction->SetOutputFormat(newValue);
+  }
+
+  if (command == fMergeCmd) {
+    fRunAction->SetNtupleMerging(fMergeCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fSamplingCmd) {
+    G4String mode;
+    G4double value = 1.;
+    std::istringstream is(newValue);
+    is >> mode >> value;
+    fRunAction->GetEventSampler().SetMode(mode, value);
+  }
+
+  if (command == fSamplingSeedCmd) {
+    fRunAction->GetEventSampler().SetSeed(fSamplingSeedCmd->GetNewIntValue(newValue));
+  }
+
+  if (command == fMeshActiveCmd) {
+    fRunAction->SetDoseMeshActive(fMeshActiveCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fVoxelSizeCmd) {
+    fRunAction->SetVoxelSize(fVoxelSizeCmd->GetNewDoubleValue(newValue));
+  }
+
+  if (command == fStorageCmd) {
+    fRunAction->SetSparseDoseMesh(newValue == "sparse");
+  }
+
+  if (command == fProfileActiveCmd) {
+    fRunAction->SetProfileActive(fProfileActiveCmd->GetNewBoolValue(newValue));
+  }
+
+  if (command == fProfilePeriodCmd) {
+    fRunAction->SetProfileSamplingPeriod(fProfilePeriodCmd->GetNewIntValue(newValue));
+  }
+
+  if (command == fProfileJsonCmd) {
+    fRunAction->SetProfileJsonFile(newValue);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
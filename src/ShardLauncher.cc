@@ -0,0 +1,325 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ShardLauncher.cc
+/// \brief Implementation of the ShardLauncher class
+
+#include "ShardLauncher.hh"
+
+#include "DoseMesh.hh"
+#include "OutputShards.hh"
+
+#include "G4Threading.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sched.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+const char* const kDirectory = "dna.shards";
+
+fs::path ShardPath(G4int index)
+{
+  return fs::path(kDirectory) / ("shard" + std::to_string(index));
+}
+
+// Events of the last run of a shard, from its log (see RunAction)
+G4int ReadNumberOfEvents(const fs::path& log)
+{
+  std::ifstream file(log);
+  std::string line;
+  G4int events = -1;
+  while (std::getline(file, line)) {
+    std::istringstream tokens(line);
+    std::string dashes, key, name;
+    tokens >> dashes >> key >> name;
+    if (dashes == "---" && key == "Run:" && name == "events") tokens >> events;
+  }
+  return events;
+}
+
+#ifndef _WIN32
+// Runs the executable with the arguments in the directory, with its output
+// in the log; returns the process ID, -1 on error
+pid_t Spawn(const std::string& executable, const std::vector<std::string>& arguments,
+            const fs::path& directory, const fs::path& log, G4int firstCpu, G4int nofCpus)
+{
+  pid_t pid = fork();
+  if (pid != 0) return pid;
+
+  if (chdir(directory.c_str()) != 0) _exit(127);
+  int output = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (output < 0) _exit(127);
+  dup2(output, STDOUT_FILENO);
+  dup2(output, STDERR_FILENO);
+  close(output);
+
+#  ifdef __linux__
+  // Contiguous cores, usually on the same NUMA node
+  if (nofCpus > 0) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (G4int cpu = firstCpu; cpu < firstCpu + nofCpus; ++cpu) {
+      CPU_SET(cpu, &cpus);
+    }
+    sched_setaffinity(0, sizeof(cpus), &cpus);
+  }
+#  else
+  (void)firstCpu;
+  (void)nofCpus;
+#  endif
+
+  std::vector<char*> argv;
+  argv.push_back(const_cast<char*>(executable.c_str()));
+  for (const auto& argument : arguments) {
+    argv.push_back(const_cast<char*>(argument.c_str()));
+  }
+  argv.push_back(nullptr);
+  execv(executable.c_str(), argv.data());
+  _exit(127);
+}
+
+// Exit code of the process, -1 if it did not exit normally
+G4int Wait(pid_t pid, pid_t* finished = nullptr)
+{
+  int status = 0;
+  pid_t done = waitpid(pid, &status, 0);
+  if (finished != nullptr) *finished = done;
+  if (done < 0) return -1;
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+#endif
+}  // namespace
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ShardLauncher::ShardLauncher(G4int nofShards, std::uint64_t seed)
+  : fNumberOfShards(nofShards), fSeed(seed)
+{
+  if (fSeed == 0) {
+    std::random_device device;
+    fSeed = ((std::uint64_t)device() << 32) | device();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifdef _WIN32
+
+G4int ShardLauncher::Run(const std::vector<std::string>&)
+{
+  G4cerr << "dnaphysics: --shards needs a POSIX system" << G4endl;
+  return 1;
+}
+
+G4bool ShardLauncher::Merge(const std::string&) const
+{
+  return false;
+}
+
+#else
+
+G4int ShardLauncher::Run(const std::vector<std::string>& arguments)
+{
+  if (arguments.size() < 2) {
+    G4cerr << "dnaphysics: --shards needs a macro" << G4endl;
+    return 1;
+  }
+
+  // Same executable, run from the shard directories
+  std::error_code error;
+  fs::path executable = fs::read_symlink("/proc/self/exe", error);
+  if (error) executable = fs::absolute(arguments[0]);
+  fs::path macro = fs::absolute(arguments[1]);
+  if (!fs::exists(macro)) {
+    G4cerr << "dnaphysics: cannot find the macro " << macro.string() << G4endl;
+    return 1;
+  }
+
+  // Threads of each process, by default the cores divided between them
+  G4int nofCores = G4Threading::G4GetNumberOfCores();
+  G4int nThreads = (arguments.size() >= 3) ? std::atoi(arguments[2].c_str()) : 0;
+  if (nThreads <= 0) nThreads = std::max(1, nofCores / fNumberOfShards);
+  G4bool pinned = nThreads * fNumberOfShards <= nofCores;
+
+  // A resumed sharded run keeps the checkpoints of its shards
+  G4bool resume = false;
+  for (const auto& argument : arguments) {
+    if (argument == "--resume") resume = true;
+  }
+  if (!resume) fs::remove_all(kDirectory, error);
+
+  char seed[32];
+  std::snprintf(seed, sizeof(seed), "%llx", (unsigned long long)fSeed);
+  G4cout << "--- Sharded run: " << fNumberOfShards << " processes of " << nThreads
+         << " threads, seed " << seed << " (reproduce with --seed 0x" << seed << ")" << G4endl;
+
+  auto start = std::chrono::steady_clock::now();
+  std::map<pid_t, G4int> running;
+  for (G4int k = 0; k < fNumberOfShards; ++k) {
+    fs::path directory = ShardPath(k);
+    fs::create_directories(directory, error);
+
+    std::vector<std::string> shardArguments = {macro.string(), std::to_string(nThreads)};
+    if (arguments.size() >= 4) shardArguments.push_back(arguments[3]);
+    shardArguments.insert(shardArguments.end(),
+                          {"--shard", std::to_string(k), std::to_string(fNumberOfShards), seed});
+    if (resume) shardArguments.emplace_back("--resume");
+
+    pid_t pid = Spawn(executable.string(), shardArguments, directory, "dnaphysics.out",
+                      k * nThreads, pinned ? nThreads : 0);
+    if (pid < 0) {
+      G4cerr << "dnaphysics: cannot start shard " << k << G4endl;
+      continue;
+    }
+    running[pid] = k;
+  }
+
+  // Monitoring: each process is reported when it ends
+  G4int nofFailed = fNumberOfShards - (G4int)running.size();
+  while (!running.empty()) {
+    pid_t pid = 0;
+    G4int status = Wait(-1, &pid);
+    if (pid < 0) break;
+    auto shard = running.find(pid);
+    if (shard == running.end()) continue;
+
+    std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - start;
+    G4int k = shard->second;
+    running.erase(shard);
+    G4cout << "--- Shard " << k << ": ";
+    if (status == 0) {
+      G4cout << "done in " << elapsed.count() << " s";
+    }
+    else {
+      G4cout << "FAILED (exit code " << status << ") after " << elapsed.count() << " s, see "
+             << (ShardPath(k) / "dnaphysics.out").string();
+      ++nofFailed;
+    }
+    G4cout << ", " << running.size() << " running" << G4endl;
+  }
+
+  if (nofFailed > 0) {
+    G4cerr << "dnaphysics: " << nofFailed << " shard(s) failed; outputs left in " << kDirectory
+           << " (rerun with --resume if checkpointed)" << G4endl;
+    return 1;
+  }
+  return Merge(executable.string()) ? 0 : 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool ShardLauncher::Merge(const std::string& executable) const
+{
+  // Outputs of the last run of each process, as shards dna_s<k>...
+  OutputShards shards;
+  try {
+    OutputShards::RemoveOutputs();
+    for (G4int k = 0; k < fNumberOfShards; ++k) {
+      fs::path directory = ShardPath(k);
+      G4int events = ReadNumberOfEvents(directory / "dnaphysics.out");
+      if (events < 0) {
+        G4cerr << "dnaphysics: no run in " << (directory / "dnaphysics.out").string() << G4endl;
+        return false;
+      }
+      shards.Add(directory.string(), "_s" + std::to_string(k), events);
+    }
+    shards.Combine(true, "sharded run");
+  }
+  catch (const fs::filesystem_error& error) {
+    G4cerr << "dnaphysics: cannot collect the shard outputs: " << error.what() << G4endl;
+    return false;
+  }
+
+  // Dose meshes (/dna/mesh/) are additive: the doses of the shards are summed
+  DoseMesh mesh;
+  G4double density = 0.;
+  G4int nofMeshes = 0;
+  for (G4int k = 0; k < fNumberOfShards; ++k) {
+    fs::path file = ShardPath(k) / "dna.dose";
+    if (!fs::exists(file)) continue;
+    DoseMesh part;
+    if (!part.Read(file.string(), density)) {
+      G4cerr << "dnaphysics: cannot read the dose mesh " << file.string() << G4endl;
+      return false;
+    }
+    if (nofMeshes == 0) {
+      mesh = part;
+    }
+    else {
+      mesh.Merge(part);
+    }
+    ++nofMeshes;
+  }
+  if (nofMeshes > 0) {
+    mesh.Write("dna.dose", density);
+    G4cout << "--- Dose meshes of " << nofMeshes << " shards summed into dna.dose" << G4endl;
+  }
+  // Merged with dnamerge, installed with dnaphysics
+  fs::path merger = fs::path(executable).parent_path() / "dnamerge";
+  if (!fs::exists(merger)) {
+    G4cout << "--- Shard outputs listed in dna.manifest (merge them with dnamerge)" << G4endl;
+    return true;
+  }
+  G4cout << "--- Merging the shard outputs with " << merger.string() << G4endl;
+  pid_t pid = Spawn(merger.string(), {"dna.manifest"}, ".", "dnamerge.out", 0, 0);
+  G4int status = (pid < 0) ? -1 : Wait(pid);
+  if (status != 0) {
+    G4cerr << "dnaphysics: dnamerge failed, see dnamerge.out" << G4endl;
+    return false;
+  }
+  G4cout << "--- Sharded run merged (see dnamerge.out)" << G4endl;
+  return true;
+}
+
+#endif
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
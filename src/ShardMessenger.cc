@@ -0,0 +1,94 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ShardMessenger.cc
+/// \brief Implementation of the ShardMessenger class
+
+#include "ShardMessenger.hh"
+#include "ShardSelection.hh"
+
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <cstdlib>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ShardMessenger::ShardMessenger(ShardSelection* selection) : fSelection(selection)
+{
+  fShardDir = new G4UIdirectory("/dna/shard/");
+  fShardDir->SetGuidance("events of one process of a sharded run (dnaphysics --shards N)");
+
+  fSelectCmd = new G4UIcommand("/dna/shard/select", this);
+  fSelectCmd->SetGuidance("Process the part index of N of the events of each run");
+  fSelectCmd->SetGuidance("(set by the --shards option of dnaphysics for each process).");
+  fSelectCmd->SetGuidance("The events are seeded from the seed (hexadecimal), the run ID");
+  fSelectCmd->SetGuidance("and their event ID, the same whatever the number of shards.");
+  auto indexPrm = new G4UIparameter("index", 'i', false);
+  indexPrm->SetParameterRange("index>=0");
+  fSelectCmd->SetParameter(indexPrm);
+  auto shardsPrm = new G4UIparameter("shards", 'i', false);
+  shardsPrm->SetParameterRange("shards>=1");
+  fSelectCmd->SetParameter(shardsPrm);
+  auto seedPrm = new G4UIparameter("seed", 's', false);
+  fSelectCmd->SetParameter(seedPrm);
+  fSelectCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ShardMessenger::~ShardMessenger()
+{
+  delete fSelectCmd;
+  delete fShardDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ShardMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fSelectCmd) {
+    G4int index = 0;
+    G4int nofShards = 1;
+    G4String seed;
+    std::istringstream is(newValue);
+    is >> index >> nofShards >> seed;
+    fSelection->Select(index, nofShards, std::strtoull(seed.c_str(), nullptr, 16));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,112 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file ShardSelection.cc
+/// \brief Implementation of the ShardSelection class
+
+#include "ShardSelection.hh"
+#include "ShardMessenger.hh"
+
+#include "RunAction.hh"
+
+#include "G4Run.hh"
+#include "G4Threading.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ShardSelection::ShardSelection(RunAction* runAction) : fRunAction(runAction)
+{
+  fMessenger = new ShardMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ShardSelection::~ShardSelection()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ShardSelection::Select(G4int index, G4int nofShards, std::uint64_t seed)
+{
+  if (index < 0 || index >= nofShards) {
+    G4ExceptionDescription description;
+    description << "Shard " << index << " out of 0-" << nofShards - 1 << "; ignored.";
+    G4Exception("ShardSelection::Select()", "dnaphysics010", JustWarning, description);
+    return;
+  }
+  fActive = true;
+  fIndex = index;
+  fNumberOfShards = nofShards;
+  fSeed = seed;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ShardSelection::BeginOfRun(const G4Run* aRun)
+{
+  EventSeeder& seeder = fRunAction->GetEventSeeder();
+  fSavedSeeder = seeder;
+  if (!IsActive()) return;
+
+  // Seed of the run, different for each run of the macro
+  std::uint64_t seed = fSeed ^ ((std::uint64_t)(aRun->GetRunID() + 1) * 0x9e3779b97f4a7c15ULL);
+  seed = (seed ^ (seed >> 31)) * 0xbf58476d1ce4e5b9ULL;
+
+  // Events of this process
+  G4long nofEvents = aRun->GetNumberOfEventToBeProcessed();
+  G4int first = (G4int)(fIndex * nofEvents / fNumberOfShards);
+  G4int last = (G4int)((fIndex + 1) * nofEvents / fNumberOfShards);
+
+  seeder.Reset();
+  seeder.SetSeed(seed | 1);
+  seeder.SetFirstEvent(first);
+  seeder.SetNumberOfEvents(last - first);
+
+  if (G4Threading::IsMasterThread()) {
+    G4cout << "--- Shard " << fIndex << " of " << fNumberOfShards << ": events " << first
+           << " to " << last - 1 << " of " << nofEvents << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ShardSelection::EndOfRun(const G4Run*)
+{
+  fRunAction->GetEventSeeder() = fSavedSeeder;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
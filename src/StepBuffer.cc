@@ -0,0 +1,331 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file StepBuffer.cc
+/// \brief Implementation of the StepBuffer class
+
+#include "StepBuffer.hh"
+
+#include "ColumnWriter.hh"
+#include "StepClassifier.hh"
+
+#include "G4AnalysisManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StepBuffer::StepBuffer(std::size_t capacity)
+{
+  Resize(capacity);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepBuffer::Resize(std::size_t capacity)
+{
+  fCapacity = capacity;
+
+  for (auto column : {&fPreX, &fPreY, &fPreZ, &fPostX, &fPostY, &fPostZ, &fPreDirX, &fPreDirY,
+                      &fPreDirZ, &fPostDirX, &fPostDirY, &fPostDirZ, &fEnergyDeposit,
+                      &fPreKineticEnergy, &fPostKineticEnergy, &fStepLength,
+                      &fKineticEnergyDifference, &fCosTheta, &fWeight})
+  {
+    column->resize(fCapacity);
+  }
+
+  for (auto column : {&fFlagParticle, &fFlagProcess, &fEventIDs, &fTrackID, &fParentID, &fStepID})
+  {
+    column->resize(fCapacity);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepBuffer::Add(const G4Step* step, G4int flagParticle, G4int flagProcess,
+                     G4double weight)
+{
+  if (fSize == fCapacity) {
+    if (fHold || fCapacity == 0) {
+      Resize(std::max<std::size_t>(2 * fCapacity, 4096));
+    }
+    else {
+      Flush();
+    }
+  }
+
+  const G4StepPoint* preStep = step->GetPreStepPoint();
+  const G4StepPoint* postStep = step->GetPostStepPoint();
+  const G4Track* track = step->GetTrack();
+
+  const G4ThreeVector& prePosition = preStep->GetPosition();
+  const G4ThreeVector& postPosition = postStep->GetPosition();
+  const G4ThreeVector& preDirection = preStep->GetMomentumDirection();
+
+  // Change of the primary before the roulette of a biased multiple
+  // ionisation, consistent with the weight of the step
+  G4double postKineticEnergy = 0.;
+  G4ThreeVector postDirection;
+  StepClassifier::PostStepChange(step, flagProcess, postKineticEnergy, postDirection);
+
+  std::size_t i = fSize++;
+
+  fFlagParticle[i] = flagParticle;
+  fFlagProcess[i] = flagProcess;
+
+  fPreX[i] = prePosition.x();
+  fPreY[i] = prePosition.y();
+  fPreZ[i] = prePosition.z();
+  fPostX[i] = postPosition.x();
+  fPostY[i] = postPosition.y();
+  fPostZ[i] = postPosition.z();
+
+  fPreDirX[i] = preDirection.x();
+  fPreDirY[i] = preDirection.y();
+  fPreDirZ[i] = preDirection.z();
+  fPostDirX[i] = postDirection.x();
+  fPostDirY[i] = postDirection.y();
+  fPostDirZ[i] = postDirection.z();
+
+  fEnergyDeposit[i] = step->GetTotalEnergyDeposit();
+  fPreKineticEnergy[i] = preStep->GetKineticEnergy();
+  fPostKineticEnergy[i] = postKineticEnergy;
+
+  fEventIDs[i] = fEventID;
+  fTrackID[i] = track->GetTrackID();
+  fParentID[i] = track->GetParentID();
+  fStepID[i] = track->GetCurrentStepNumber();
+  fWeight[i] = weight;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepBuffer::SwapRows(StepBuffer& other)
+{
+  // Exchanges the recorded rows only, not the output settings
+  std::swap(fCapacity, other.fCapacity);
+  std::swap(fSize, other.fSize);
+
+  fFlagParticle.swap(other.fFlagParticle);
+  fFlagProcess.swap(other.fFlagProcess);
+  fPreX.swap(other.fPreX);
+  fPreY.swap(other.fPreY);
+  fPreZ.swap(other.fPreZ);
+  fPostX.swap(other.fPostX);
+  fPostY.swap(other.fPostY);
+  fPostZ.swap(other.fPostZ);
+  fPreDirX.swap(other.fPreDirX);
+  fPreDirY.swap(other.fPreDirY);
+  fPreDirZ.swap(other.fPreDirZ);
+  fPostDirX.swap(other.fPostDirX);
+  fPostDirY.swap(other.fPostDirY);
+  fPostDirZ.swap(other.fPostDirZ);
+  fEnergyDeposit.swap(other.fEnergyDeposit);
+  fPreKineticEnergy.swap(other.fPreKineticEnergy);
+  fPostKineticEnergy.swap(other.fPostKineticEnergy);
+  fEventIDs.swap(other.fEventIDs);
+  fTrackID.swap(other.fTrackID);
+  fParentID.swap(other.fParentID);
+  fStepID.swap(other.fStepID);
+  fWeight.swap(other.fWeight);
+  fStepLength.swap(other.fStepLength);
+  fKineticEnergyDifference.swap(other.fKineticEnergyDifference);
+  fCosTheta.swap(other.fCosTheta);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepBuffer::Flush()
+{
+  if (fSize == 0) return;
+
+  ComputeDerivedColumns();
+
+  auto start = std::chrono::steady_clock::now();
+  if (fColumnWriter != nullptr) {
+    WriteColumns();
+  }
+  else {
+    WriteBlock();
+  }
+  std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - start;
+  fWriteTime += elapsed.count();
+  fRowsWritten += fSize;
+
+  fSize = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepBuffer::ResetStatistics()
+{
+  fRowsWritten = 0;
+  fWriteTime = 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepBuffer::ComputeDerivedColumns()
+{
+  // Each loop runs over contiguous arrays without branches,
+  // so that the compiler can vectorise it
+
+  const std::size_t n = fSize;
+
+  const G4double* x = fPreX.data();
+  const G4double* y = fPreY.data();
+  const G4double* z = fPreZ.data();
+  G4double* xp = fPostX.data();
+  G4double* yp = fPostY.data();
+  G4double* zp = fPostZ.data();
+  G4double* length = fStepLength.data();
+
+  for (std::size_t i = 0; i < n; ++i) {
+    G4double dx = x[i] - xp[i];
+    G4double dy = y[i] - yp[i];
+    G4double dz = z[i] - zp[i];
+    length[i] = std::sqrt(dx * dx + dy * dy + dz * dz) / nanometer;
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    xp[i] /= nanometer;
+    yp[i] /= nanometer;
+    zp[i] /= nanometer;
+  }
+
+  const G4double* u = fPreDirX.data();
+  const G4double* v = fPreDirY.data();
+  const G4double* w = fPreDirZ.data();
+  const G4double* up = fPostDirX.data();
+  const G4double* vp = fPostDirY.data();
+  const G4double* wp = fPostDirZ.data();
+  G4double* cosTheta = fCosTheta.data();
+
+  for (std::size_t i = 0; i < n; ++i) {
+    cosTheta[i] = u[i] * up[i] + v[i] * vp[i] + w[i] * wp[i];
+  }
+
+  G4double* edep = fEnergyDeposit.data();
+  G4double* ekin = fPreKineticEnergy.data();
+  const G4double* ekinp = fPostKineticEnergy.data();
+  G4double* ediff = fKineticEnergyDifference.data();
+
+  for (std::size_t i = 0; i < n; ++i) {
+    ediff[i] = (ekin[i] - ekinp[i]) / eV;
+    ekin[i] /= eV;
+    edep[i] /= eV;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepBuffer::WriteBlock()
+{
+  // G4AnalysisManager has no block interface: rows are filled in a single
+  // tight loop over the buffer
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+
+  if (fCompactSchema) {
+    for (std::size_t i = 0; i < fSize; ++i) {
+      analysisManager->FillNtupleIColumn(0, fFlagParticle[i]);
+      analysisManager->FillNtupleIColumn(1, fFlagProcess[i]);
+      analysisManager->FillNtupleFColumn(2, (G4float)fPostX[i]);
+      analysisManager->FillNtupleFColumn(3, (G4float)fPostY[i]);
+      analysisManager->FillNtupleFColumn(4, (G4float)fPostZ[i]);
+      analysisManager->FillNtupleFColumn(5, (G4float)fEnergyDeposit[i]);
+      analysisManager->FillNtupleFColumn(6, (G4float)fStepLength[i]);
+      analysisManager->FillNtupleFColumn(7, (G4float)fKineticEnergyDifference[i]);
+      analysisManager->FillNtupleFColumn(8, (G4float)fPreKineticEnergy[i]);
+      analysisManager->FillNtupleFColumn(9, (G4float)fCosTheta[i]);
+      analysisManager->FillNtupleIColumn(10, fEventIDs[i]);
+      analysisManager->FillNtupleIColumn(11, fTrackID[i]);
+      analysisManager->FillNtupleIColumn(12, fParentID[i]);
+      analysisManager->FillNtupleIColumn(13, fStepID[i]);
+      analysisManager->FillNtupleFColumn(14, (G4float)fWeight[i]);
+      analysisManager->AddNtupleRow();
+    }
+    return;
+  }
+
+  for (std::size_t i = 0; i < fSize; ++i) {
+    analysisManager->FillNtupleDColumn(0, fFlagParticle[i]);
+    analysisManager->FillNtupleDColumn(1, fFlagProcess[i]);
+    analysisManager->FillNtupleDColumn(2, fPostX[i]);
+    analysisManager->FillNtupleDColumn(3, fPostY[i]);
+    analysisManager->FillNtupleDColumn(4, fPostZ[i]);
+    analysisManager->FillNtupleDColumn(5, fEnergyDeposit[i]);
+    analysisManager->FillNtupleDColumn(6, fStepLength[i]);
+    analysisManager->FillNtupleDColumn(7, fKineticEnergyDifference[i]);
+    analysisManager->FillNtupleDColumn(8, fPreKineticEnergy[i]);
+    analysisManager->FillNtupleDColumn(9, fCosTheta[i]);
+    analysisManager->FillNtupleIColumn(10, fEventIDs[i]);
+    analysisManager->FillNtupleIColumn(11, fTrackID[i]);
+    analysisManager->FillNtupleIColumn(12, fParentID[i]);
+    analysisManager->FillNtupleIColumn(13, fStepID[i]);
+    analysisManager->FillNtupleDColumn(14, fWeight[i]);
+    analysisManager->AddNtupleRow();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepBuffer::WriteColumns()
+{
+  // Columns are added by RunAction in the order of the step ntuple
+  const std::size_t n = fSize;
+  ColumnWriter& writer = *fColumnWriter;
+
+  writer.Write(0, fFlagParticle.data(), n);
+  writer.Write(1, fFlagProcess.data(), n);
+  writer.Write(2, fPostX.data(), n);
+  writer.Write(3, fPostY.data(), n);
+  writer.Write(4, fPostZ.data(), n);
+  writer.Write(5, fEnergyDeposit.data(), n);
+  writer.Write(6, fStepLength.data(), n);
+  writer.Write(7, fKineticEnergyDifference.data(), n);
+  writer.Write(8, fPreKineticEnergy.data(), n);
+  writer.Write(9, fCosTheta.data(), n);
+  writer.Write(10, fEventIDs.data(), n);
+  writer.Write(11, fTrackID.data(), n);
+  writer.Write(12, fParentID.data(), n);
+  writer.Write(13, fStepID.data(), n);
+  writer.Write(14, fWeight.data(), n);
+}
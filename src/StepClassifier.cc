@@ -0,0 +1,352 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file StepClassifier.cc
+/// \brief Implementation of the StepClassifier class
+
+#include "StepClassifier.hh"
+
+#include "G4Alpha.hh"
+#include "G4DNAGenericIonsManager.hh"
+#include "G4Electron.hh"
+#include "G4Gamma.hh"
+#include "G4GenericIon.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4Proton.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepClassifier::Build()
+{
+  // 1) Particle identification
+  //
+  // The following method avoids the usage of string comparison during
+  // tracking: definitions are resolved here, once per run
+
+  G4DNAGenericIonsManager* instance;
+  instance = G4DNAGenericIonsManager::Instance();
+
+  fDefinitions = {G4Gamma::GammaDefinition(),       G4Electron::ElectronDefinition(),
+                  G4Proton::ProtonDefinition(),     instance->GetIon("hydrogen"),
+                  G4Alpha::AlphaDefinition(),       instance->GetIon("alpha+"),
+                  instance->GetIon("helium")};
+
+  fLastDefinition = nullptr;
+  fLastFlag = -1;
+  fCapture = nullptr;
+  fMultipleIonisations = {};
+
+  // 2) Process identification
+  //
+  // Reminder
+  // Process sub-types are listed in G4PhysicsListHelper.cc
+  // or in Geant4-DNA process class implementation files (*.cc)
+
+  for (G4int particle = 0; particle < kNParticles; ++particle) {
+    for (G4int subType = 0; subType < kNSubTypes; ++subType) {
+      fProcessTable[particle * kNSubTypes + subType] = SubTypeCode(particle, subType);
+    }
+  }
+
+  // The multiple ionisation processes and the ion capture are found in the
+  // process lists of the particles, where they are identified by name.
+  // They are matched by address during tracking, not through the sub-type
+  // table: the multiple ionisation processes can share the sub-type of the
+  // single ionisation, whose steps would otherwise be flagged as theirs
+
+  for (G4int particle = 0; particle < kNParticles; ++particle) {
+    const G4ParticleDefinition* partDef =
+      (particle < kNParticles - 1) ? fDefinitions[particle] : G4GenericIon::GenericIon();
+    if (nullptr == partDef || nullptr == partDef->GetProcessManager()) continue;
+
+    G4ProcessVector* processList = partDef->GetProcessManager()->GetProcessList();
+    for (G4int i = 0; i < (G4int)processList->size(); ++i) {
+      const G4VProcess* process = (*processList)[i];
+      const G4String& processName = process->GetProcessName();
+
+      if (particle == 7 && processName == "Capture") {
+        // This process is used to kill ions below tracking cut
+        // No subType and procID exists at the moment for this process
+        fCapture = process;
+        continue;
+      }
+
+      G4int code = MultipleIonisationCode(particle, processName);
+      if (code >= 0) fMultipleIonisations[particle][code % 10 - 6] = process;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int StepClassifier::ClassifyParticle(const G4ParticleDefinition* partDef) const
+{
+  G4int flagParticle = -1;
+
+  for (G4int i = 0; i < kNParticles - 1; ++i) {
+    if (partDef == fDefinitions[i]) {
+      flagParticle = i;
+      break;
+    }
+  }
+
+  // Heavier ions
+  if (partDef->GetPDGCharge() > 4) flagParticle = 7;
+
+  // Alternative method (based on string comparison ) - not recommended -
+  /*
+  const G4String& particleName = partDef->GetParticleName();
+
+  if (particleName == "gamma")         flagParticle = 0;
+  else if (particleName == "e-")       flagParticle = 1;
+  else if (particleName == "proton")   flagParticle = 2;
+  else if (particleName == "hydrogen") flagParticle = 3;
+  else if (particleName == "alpha")    flagParticle = 4;
+  else if (particleName == "alpha+")   flagParticle = 5;
+  else if (particleName == "helium")   flagParticle = 6;
+  */
+
+  return flagParticle;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int StepClassifier::SubTypeCode(G4int flagParticle, G4int procID) const
+{
+  G4int flagProcess = -1;
+
+  // For gammas
+  if (flagParticle == 0) {
+    if (procID == 12)
+      flagProcess = 81;
+    else if (procID == 13)
+      flagProcess = 82;
+    else if (procID == 14)
+      flagProcess = 83;
+    else if (procID == 11)
+      flagProcess = 84;
+  }
+
+  // For electrons
+  else if (flagParticle == 1) {
+    if (procID == 58)
+      flagProcess = 10;
+    else if (procID == 51)
+      flagProcess = 11;
+    else if (procID == 52)
+      flagProcess = 12;
+    else if (procID == 53)
+      flagProcess = 13;
+    else if (procID == 55)
+      flagProcess = 14;
+    else if (procID == 54)
+      flagProcess = 15;
+    else if (procID == 10)
+      flagProcess = 110;
+    else if (procID == 1)
+      flagProcess = 120;
+    else if (procID == 2)
+      flagProcess = 130;
+  }
+
+  // For protons
+  else if (flagParticle == 2) {
+    if (procID == 51)
+      flagProcess = 21;
+    else if (procID == 52)
+      flagProcess = 22;
+    else if (procID == 53)
+      flagProcess = 23;
+    else if (procID == 56)
+      flagProcess = 24;
+    else if (procID == 10)
+      flagProcess = 210;
+    else if (procID == 1)
+      flagProcess = 220;
+    else if (procID == 2)
+      flagProcess = 230;
+    else if (procID == 8)
+      flagProcess = 240;
+  }
+
+  // For hydrogen
+  else if (flagParticle == 3) {
+    if (procID == 51)
+      flagProcess = 31;
+    else if (procID == 52)
+      flagProcess = 32;
+    else if (procID == 53)
+      flagProcess = 33;
+    else if (procID == 57)
+      flagProcess = 35;
+  }
+
+  // For alpha
+  else if (flagParticle == 4) {
+    if (procID == 51)
+      flagProcess = 41;
+    else if (procID == 52)
+      flagProcess = 42;
+    else if (procID == 53)
+      flagProcess = 43;
+    else if (procID == 56)
+      flagProcess = 44;
+    else if (procID == 10)
+      flagProcess = 410;
+    else if (procID == 1)
+      flagProcess = 420;
+    else if (procID == 2)
+      flagProcess = 430;
+    else if (procID == 8)
+      flagProcess = 440;
+  }
+
+  // For alpha+
+  else if (flagParticle == 5) {
+    if (procID == 51)
+      flagProcess = 51;
+    else if (procID == 52)
+      flagProcess = 52;
+    else if (procID == 53)
+      flagProcess = 53;
+    else if (procID == 56)
+      flagProcess = 54;
+    else if (procID == 57)
+      flagProcess = 55;
+    else if (procID == 10)
+      flagProcess = 510;
+    else if (procID == 1)
+      flagProcess = 520;
+    else if (procID == 2)
+      flagProcess = 530;
+    else if (procID == 8)
+      flagProcess = 540;
+  }
+
+  // For helium
+  else if (flagParticle == 6) {
+    if (procID == 51)
+      flagProcess = 61;
+    else if (procID == 52)
+      flagProcess = 62;
+    else if (procID == 53)
+      flagProcess = 63;
+    else if (procID == 57)
+      flagProcess = 65;
+  }
+
+  // For generic ions (Capture is handled by ProcessFlag)
+  else if (flagParticle == 7) {
+    if (procID == 210)
+      flagProcess = 2;
+      // This is the RadioactiveDecay process
+    else if (procID == 53) // GenericIon_G4DNAIonisation
+      flagProcess = 73;
+    else if (procID == 10) // msc
+      flagProcess = 710;
+    else if (procID == 1) // CoulombScat
+      flagProcess = 720;
+    else if (procID == 2) // ionIoni
+      flagProcess = 730;
+    else if (procID == 8) // nuclearStopping
+      flagProcess = 740;
+  }
+
+  // Alternative method (based on string comparison ) - not recommended -
+  /*
+  else if (processName=="e-_G4DNAElectronSolvation")    flagProcess =10;
+  else if (processName=="e-_G4DNAElastic")              flagProcess =11;
+  else if (processName=="e-_G4DNAExcitation")           flagProcess =12;
+  else if (processName=="e-_G4DNAIonisation")           flagProcess =13;
+  else if (processName=="e-_G4DNAAttachment")           flagProcess =14;
+  else if (processName=="e-_G4DNAVibExcitation")        flagProcess =15;
+
+  else if (processName=="proton_G4DNAElastic")          flagProcess =21;
+  else if (processName=="proton_G4DNAExcitation")       flagProcess =22;
+  else if (processName=="proton_G4DNAIonisation")       flagProcess =23;
+  else if (processName=="proton_G4DNAChargeDecrease")   flagProcess =24;
+
+  else if (processName=="hydrogen_G4DNAElastic")        flagProcess =31;
+  else if (processName=="hydrogen_G4DNAExcitation")     flagProcess =32;
+  else if (processName=="hydrogen_G4DNAIonisation")     flagProcess =33;
+  else if (processName=="hydrogen_G4DNAChargeIncrease") flagProcess =35;
+
+  else if (processName=="alpha_G4DNAElastic")           flagProcess =41;
+  else if (processName=="alpha_G4DNAExcitation")        flagProcess =42;
+  else if (processName=="alpha_G4DNAIonisation")        flagProcess =43;
+  else if (processName=="alpha_G4DNAChargeDecrease")    flagProcess =44;
+
+  else if (processName=="alpha+_G4DNAElastic")          flagProcess =51;
+  else if (processName=="alpha+_G4DNAExcitation")       flagProcess =52;
+  else if (processName=="alpha+_G4DNAIonisation")       flagProcess =53;
+  else if (processName=="alpha+_G4DNAChargeDecrease")   flagProcess =54;
+  else if (processName=="alpha+_G4DNAChargeIncrease")   flagProcess =55;
+
+  else if (processName=="helium_G4DNAElastic")          flagProcess =61;
+  else if (processName=="helium_G4DNAExcitation")       flagProcess =62;
+  else if (processName=="helium_G4DNAIonisation")       flagProcess =63;
+  else if (processName=="helium_G4DNAChargeIncrease")   flagProcess =65;
+
+  else if (processName=="GenericIon_G4DNAIonisation")   flagProcess =73;
+  */
+
+  return flagProcess;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int StepClassifier::MultipleIonisationCode(G4int flagParticle,
+                                             const G4String& processName) const
+{
+  // Registered in PhysicsList::ConstructMultipleIonisationProcess
+  // for protons, hydrogen, alpha and generic ions only
+  if (flagParticle != 2 && flagParticle != 3 && flagParticle != 4 && flagParticle != 7) {
+    return -1;
+  }
+
+  G4int offset = -1;
+  if (G4StrUtil::contains(processName, "G4DNADoubleIonisation"))
+    offset = 6;
+  else if (G4StrUtil::contains(processName, "G4DNATripleIonisation"))
+    offset = 7;
+  else if (G4StrUtil::contains(processName, "G4DNAQuadrupleIonisation"))
+    offset = 8;
+
+  if (offset < 0) return -1;
+
+  // e.g. proton_G4DNADoubleIonisation: 26, GenericIon_G4DNAQuadrupleIonisation: 78
+  return flagParticle * 10 + offset;
+}
@@ -0,0 +1,143 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// This example is provided by the Geant4-DNA collaboration
+// Any report or published results obtained using the Geant4-DNA software
+// shall cite the following Geant4-DNA collaboration publications:
+// Med. Phys. 45 (2018) e722-e739
+// Phys. Med. 31 (2015) 861-874
+// Med. Phys. 37 (2010) 4692-4708
+// Int. J. Model. Simul. Sci. Comput. 1 (2010) 157–178
+//
+// The Geant4-DNA web site is available at http://geant4-dna.org
+//
+/// \file StepFilter.cc
+/// \brief Implementation of the StepFilter class
+
+#include "StepFilter.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepFilter::SetEnergyWindow(G4double min, G4double max)
+{
+  fEnergyWindowSet = true;
+  fEnergyMin = min;
+  fEnergyMax = max;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepFilter::AddBox(const G4ThreeVector& corner1, const G4ThreeVector& corner2)
+{
+  fBoxes.push_back(std::min(corner1.x(), corner2.x()));
+  fBoxes.push_back(std::min(corner1.y(), corner2.y()));
+  fBoxes.push_back(std::min(corner1.z(), corner2.z()));
+  fBoxes.push_back(std::max(corner1.x(), corner2.x()));
+  fBoxes.push_back(std::max(corner1.y(), corner2.y()));
+  fBoxes.push_back(std::max(corner1.z(), corner2.z()));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepFilter::Clear()
+{
+  fParticles.clear();
+  fProcesses.clear();
+  fEnergyWindowSet = false;
+  fBoxes.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepFilter::Compile()
+{
+  fTests = 0;
+  fParticleTable.reset();
+  fProcessTable.reset();
+
+  for (G4int flag : fParticles) {
+    fParticleTable.set(flag & kFlagMask);
+  }
+  for (G4int flag : fProcesses) {
+    fProcessTable.set(flag & kFlagMask);
+  }
+
+  if (!fParticles.empty()) fTests |= kParticle;
+  if (!fProcesses.empty()) fTests |= kProcess;
+  if (fEnergyWindowSet) fTests |= kEnergy;
+  if (!fBoxes.empty()) fTests |= kBox;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool StepFilter::InBoxes(const G4ThreeVector& position) const
+{
+  const G4double x = position.x();
+  const G4double y = position.y();
+  const G4double z = position.z();
+
+  for (std::size_t i = 0; i < fBoxes.size(); i += 6) {
+    const G4double* box = &fBoxes[i];
+    if (x >= box[0] && y >= box[1] && z >= box[2] && x < box[3] && y < box[4] && z < box[5])
+      return true;
+  }
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StepFilter::Print() const
+{
+  if (fTests == 0) return;
+
+  G4cout << "--- Step filter:";
+  if (fTests & kParticle) {
+    G4cout << " particles";
+    for (G4int flag : fParticles) {
+      G4cout << ' ' << flag;
+    }
+    G4cout << ';';
+  }
+  if (fTests & kProcess) {
+    G4cout << " processes";
+    for (G4int flag : fProcesses) {
+      G4cout << ' ' << flag;
+    }
+    G4cout << ';';
+  }
+  if (fTests & kEnergy) {
+    G4cout << " energy [" << fEnergyMin / eV << ", " << fEnergyMax / eV << ") eV;";
+  }
+  if (fTests & kBox) {
+    G4cout << ' ' << fBoxes.size() / 6 << " box(es)";
+  }
+  G4cout << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
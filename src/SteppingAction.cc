@@ -40,23 +40,44 @@
 #include "SteppingMessenger.hh"
 
 #include "DetectorConstruction.hh"
+#include "DoseMesh.hh"
+#include "ProcessProfile.hh"
 #include "PrimaryGeneratorAction.hh"
+#include "Run.hh"
 #include "RunAction.hh"
+#include "StepClassifier.hh"
 
-#include "G4Alpha.hh"
 #include "G4AnalysisManager.hh"
-#include "G4DNAGenericIonsManager.hh"
-#include "G4Electron.hh"
-#include "G4Event.hh"
-#include "G4EventManager.hh"
-#include "G4Gamma.hh"
-#include "G4Proton.hh"
 #include "G4SteppingManager.hh"
-#include "G4SystemOfUnits.hh"
+
+#include <chrono>
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+// CPU time of the calling thread, in seconds (elapsed time on Windows)
+G4double ThreadCpuTime()
+{
+#ifdef _WIN32
+  return std::chrono::duration<G4double>(std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+#else
+  timespec time;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return time.tv_sec + 1.e-9 * time.tv_nsec;
+#endif
+}
+}  // namespace
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-SteppingAction::SteppingAction() : G4UserSteppingAction() 
+SteppingAction::SteppingAction(RunAction* runAction)
+  : G4UserSteppingAction(), fRunAction(runAction)
 {
   fSteppingMessenger = new SteppingMessenger(this);
 }
@@ -70,8 +91,17 @@ SteppingAction::~SteppingAction()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+StepFilter& SteppingAction::GetStepFilter()
+{
+  return fRunAction->GetStepFilter();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void SteppingAction::UserSteppingAction(const G4Step* step)
 {
+  fRunAction->GetRun()->CountStep();
+
   // Protection
   if (!step->GetPostStepPoint()) return;
   if (!step->GetPostStepPoint()->GetProcessDefinedStep()) return;
@@ -79,293 +109,141 @@ void SteppingAction::UserSteppingAction(const G4Step* step)
   // ***** FOR FIRST STEP RECORD ONLY   
   if (step->GetTrack()->GetCurrentStepNumber()>=1 && fKill) step->GetTrack()->SetTrackStatus(fKillTrackAndSecondaries);
   //
-  
-  //
-  G4double flagParticle = -1.;
-  G4double flagProcess = -1.;
-  G4double x, y, z, xp, yp, zp;
 
-  // 1) Particle identification
-
-  // The following method avoids the usage of string comparison
-
-  G4ParticleDefinition* partDef = step->GetTrack()->GetDynamicParticle()->GetDefinition();
-
-  if (partDef == G4Gamma::GammaDefinition()) flagParticle = 0;
-
-  if (partDef == G4Electron::ElectronDefinition()) flagParticle = 1;
-
-  if (partDef == G4Proton::ProtonDefinition()) flagParticle = 2;
-
-  if (partDef == G4Alpha::AlphaDefinition()) flagParticle = 4;
+  const G4VProcess* process = step->GetPostStepPoint()->GetProcessDefinedStep();
 
-  G4DNAGenericIonsManager* instance;
-  instance = G4DNAGenericIonsManager::Instance();
+  // Steps per particle and process, including the transportation
+  ProcessProfile* profile = fRunAction->GetProcessProfile();
+  if (profile != nullptr) Profile(step, *profile);
 
-  // G4DNAGenericIonsManager usage example
-  /*
-  G4ParticleDefinition* protonDef = G4Proton::ProtonDefinition();
-  G4ParticleDefinition* hydrogenDef = instance->GetIon("hydrogen");
-  G4ParticleDefinition* alphaPlusPlusDef = instance->GetIon("alpha++");
-  G4ParticleDefinition* alphaPlusDef = instance->GetIon("alpha+");
-  G4ParticleDefinition* heliumDef = instance->GetIon("helium");
-  */
-
-  if (partDef == instance->GetIon("hydrogen")) flagParticle = 3;
-
-  if (partDef == instance->GetIon("alpha+")) flagParticle = 5;
-
-  if (partDef == instance->GetIon("helium")) flagParticle = 6;
-
-  // Heavier ions
-  if (partDef->GetPDGCharge()>4) flagParticle = 7;
+  // Path of the primary, including the steps limited by the transportation
+  RadialDoseScorer& radial = fRunAction->GetRadialDoseScorer();
+  G4bool primary = step->GetTrack()->GetTrackID() == 1;
+  if (radial.IsActive() && primary) {
+    radial.AddPrimarySegment(step->GetPreStepPoint()->GetPosition(),
+                             step->GetPostStepPoint()->GetPosition());
+  }
 
-  // Alternative method (based on string comparison ) - not recommended -
-  /*
-  const G4String& particleName = step->GetTrack()->GetDynamicParticle()->
-      GetDefinition()->GetParticleName();
+  StepClassifier& classifier = fRunAction->GetStepClassifier();
 
-  if (particleName == "gamma")         flagParticle = 0;
-  else if (particleName == "e-")       flagParticle = 1;
-  else if (particleName == "proton")   flagParticle = 2;
-  else if (particleName == "hydrogen") flagParticle = 3;
-  else if (particleName == "alpha")    flagParticle = 4;
-  else if (particleName == "alpha+")   flagParticle = 5;
-  else if (particleName == "helium")   flagParticle = 6;
-  */
+  if (classifier.IsTransportation(process)) return;
 
+  // 1) Particle identification
   // 2) Process identification
   //
-  // Reminder
-  // Process sub-types are listed in G4PhysicsListHelper.cc
-  // or in Geant4-DNA process class implementation files (*.cc)
-
-  G4StepPoint* preStep = step->GetPreStepPoint();
-  G4StepPoint* postStep = step->GetPostStepPoint();
-  G4int procID = postStep->GetProcessDefinedStep()->GetProcessSubType();
-
-  const G4String& processName = postStep->GetProcessDefinedStep()->GetProcessName();
-
-  // For gammas
-  if (flagParticle == 0) {
-    if (procID == 12)
-      flagProcess = 81;
-    else if (procID == 13)
-      flagProcess = 82;
-    else if (procID == 14)
-      flagProcess = 83;
-    else if (procID == 11)
-      flagProcess = 84;
+  // Both are read from the table built by StepClassifier at the beginning
+  // of the run (see StepClassifier.cc and README for the numbering)
+
+  G4int flagParticle =
+    classifier.ParticleFlag(step->GetTrack()->GetDynamicParticle()->GetDefinition());
+  G4int flagProcess = classifier.ProcessFlag(flagParticle, process);
+
+  // Statistical weight of the step (see /dna/mi/bias), applied to all the
+  // tallies but the event-by-event ones (lineal energy, clustering)
+  G4double weight = StepClassifier::StepWeight(step, flagProcess);
+  G4int multiplicity = StepClassifier::Multiplicity(flagProcess);
+  if (multiplicity > 0) fRunAction->GetRun()->AddMultipleIonisation(multiplicity, weight);
+
+  // Energy deposits for the lineal energy scorer, the clustering, the dose
+  // mesh and the radial dose, at the same position as in the step ntuple
+  G4double edep = step->GetTotalEnergyDeposit();
+  if (edep > 0.) {
+    const G4ThreeVector& position = step->GetPostStepPoint()->GetPosition();
+    MicrodosimetryScorer& scorer = fRunAction->GetMicrodosimetryScorer();
+    if (scorer.IsActive()) scorer.AddDeposit(position, edep);
+    DamageClusterer& clusterer = fRunAction->GetDamageClusterer();
+    if (clusterer.IsActive()) clusterer.AddPoint(position, edep);
+    DoseMesh* mesh = fRunAction->GetDoseMesh();
+    if (mesh != nullptr) mesh->Fill(position, weight * edep);
+    if (radial.IsActive()) {
+      if (primary) {
+        radial.AddPrimaryDeposit(weight * edep);
+      }
+      else {
+        radial.AddDeposit(position, weight * edep);
+      }
+    }
   }
 
-  // For electrons
-  else if (flagParticle == 1) {
-    if (procID == 58)
-      flagProcess = 10;
-    else if (procID == 51)
-      flagProcess = 11;
-    else if (procID == 52)
-      flagProcess = 12;
-    else if (procID == 53)
-      flagProcess = 13;
-    else if (procID == 55)
-      flagProcess = 14;
-    else if (procID == 54)
-      flagProcess = 15;
-    else if (procID == 10)
-      flagProcess = 110;
-    else if (procID == 1)
-      flagProcess = 120;
-    else if (procID == 2)
-      flagProcess = 130;
+  // Steps rejected by the /step/filter/ rules are neither histogrammed
+  // nor buffered
+  const StepFilter& filter = fRunAction->GetStepFilter();
+  if (filter.IsActive()
+      && !filter.Accept(flagParticle, flagProcess, step->GetPreStepPoint()->GetKineticEnergy(),
+                        step->GetPostStepPoint()->GetPosition()))
+    return;
+
+  if (fRunAction->IsHistogramOutput()) {
+    FillHistograms(step, flagProcess, weight);
+    return;
   }
 
-  // For protons
-  else if (flagParticle == 2) {
-    if (procID == 51)
-      flagProcess = 21;
-    else if (procID == 52)
-      flagProcess = 22;
-    else if (procID == 53)
-      flagProcess = 23;
-    else if (procID == 56)
-      flagProcess = 24;
-    else if (procID == 10)
-      flagProcess = 210;
-    else if (procID == 1)
-      flagProcess = 220;
-    else if (procID == 2)
-      flagProcess = 230;
-    else if (procID == 8)
-      flagProcess = 240;
-  }
-
-  // For hydrogen
-  else if (flagParticle == 3) {
-    if (procID == 51)
-      flagProcess = 31;
-    else if (procID == 52)
-      flagProcess = 32;
-    else if (procID == 53)
-      flagProcess = 33;
-    else if (procID == 57)
-      flagProcess = 35;
-  }
-
-  // For alpha
-  else if (flagParticle == 4) {
-    if (procID == 51)
-      flagProcess = 41;
-    else if (procID == 52)
-      flagProcess = 42;
-    else if (procID == 53)
-      flagProcess = 43;
-    else if (procID == 56)
-      flagProcess = 44;
-    else if (procID == 10)
-      flagProcess = 410;
-    else if (procID == 1)
-      flagProcess = 420;
-    else if (procID == 2)
-      flagProcess = 430;
-    else if (procID == 8)
-      flagProcess = 440;
-  }
-
-  // For alpha+
-  else if (flagParticle == 5) {
-    if (procID == 51)
-      flagProcess = 51;
-    else if (procID == 52)
-      flagProcess = 52;
-    else if (procID == 53)
-      flagProcess = 53;
-    else if (procID == 56)
-      flagProcess = 54;
-    else if (procID == 57)
-      flagProcess = 55;
-    else if (procID == 10)
-      flagProcess = 510;
-    else if (procID == 1)
-      flagProcess = 520;
-    else if (procID == 2)
-      flagProcess = 530;
-    else if (procID == 8)
-      flagProcess = 540;
-  }
-
-  // For helium
-  else if (flagParticle == 6) {
-    if (procID == 51)
-      flagProcess = 61;
-    else if (procID == 52)
-      flagProcess = 62;
-    else if (procID == 53)
-      flagProcess = 63;
-    else if (procID == 57)
-      flagProcess = 65;
-  }
-
-  else if (flagParticle == 7) {
-    // For generic ions
-    if (processName == "Capture")
-      flagProcess = 1;
-      // This process is used to kill ions below tracking cut
-      // No subType and procID exists at the moment for this process,
-      // so testing is performed using string comparison
-    else if (procID == 210)
-      flagProcess = 2;
-      // This is the RadioactiveDecay process
-    else if (procID == 53) // GenericIon_G4DNAIonisation
-      flagProcess = 73;
-    else if (procID == 10) // msc
-      flagProcess = 710;
-    else if (procID == 1) // CoulombScat
-      flagProcess = 720;
-    else if (procID == 2) // ionIoni
-      flagProcess = 730;
-    else if (procID == 8) // nuclearStopping
-      flagProcess = 740;
-  }
-
-  // Alternative method (based on string comparison ) - not recommended -
-  /*
-  else if (processName=="e-_G4DNAElectronSolvation")    flagProcess =10;
-  else if (processName=="e-_G4DNAElastic")              flagProcess =11;
-  else if (processName=="e-_G4DNAExcitation")           flagProcess =12;
-  else if (processName=="e-_G4DNAIonisation")           flagProcess =13;
-  else if (processName=="e-_G4DNAAttachment")           flagProcess =14;
-  else if (processName=="e-_G4DNAVibExcitation")        flagProcess =15;
-
-  else if (processName=="proton_G4DNAElastic")          flagProcess =21;
-  else if (processName=="proton_G4DNAExcitation")       flagProcess =22;
-  else if (processName=="proton_G4DNAIonisation")       flagProcess =23;
-  else if (processName=="proton_G4DNAChargeDecrease")   flagProcess =24;
-
-  else if (processName=="hydrogen_G4DNAElastic")        flagProcess =31;
-  else if (processName=="hydrogen_G4DNAExcitation")     flagProcess =32;
-  else if (processName=="hydrogen_G4DNAIonisation")     flagProcess =33;
-  else if (processName=="hydrogen_G4DNAChargeIncrease") flagProcess =35;
-
-  else if (processName=="alpha_G4DNAElastic")           flagProcess =41;
-  else if (processName=="alpha_G4DNAExcitation")        flagProcess =42;
-  else if (processName=="alpha_G4DNAIonisation")        flagProcess =43;
-  else if (processName=="alpha_G4DNAChargeDecrease")    flagProcess =44;
-
-  else if (processName=="alpha+_G4DNAElastic")          flagProcess =51;
-  else if (processName=="alpha+_G4DNAExcitation")       flagProcess =52;
-  else if (processName=="alpha+_G4DNAIonisation")       flagProcess =53;
-  else if (processName=="alpha+_G4DNAChargeDecrease")   flagProcess =54;
-  else if (processName=="alpha+_G4DNAChargeIncrease")   flagProcess =55;
-
-  else if (processName=="helium_G4DNAElastic")          flagProcess =61;
-  else if (processName=="helium_G4DNAExcitation")       flagProcess =62;
-  else if (processName=="helium_G4DNAIonisation")       flagProcess =63;
-  else if (processName=="helium_G4DNAChargeIncrease")   flagProcess =65;
-
-  else if (processName=="GenericIon_G4DNAIonisation")   flagProcess =73;
-  */
+  // Events and steps sampled out by /dna/output/sampling
+  if (!fRunAction->GetEventSampler().KeepStep()) return;
 
   // 3) Fill ntuples
+  //
+  // Only the raw step data is stored here; the ntuple columns are computed
+  // and filled block-wise by StepBuffer at the end of the event
 
-  if (processName != "Transportation") {
-    x = preStep->GetPosition().x() / nanometer;
-    y = preStep->GetPosition().y() / nanometer;
-    z = preStep->GetPosition().z() / nanometer;
-
-    xp = postStep->GetPosition().x() / nanometer;
-    yp = postStep->GetPosition().y() / nanometer;
-    zp = postStep->GetPosition().z() / nanometer;
-
-    G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
-
-    analysisManager->FillNtupleDColumn(0, flagParticle);
-    analysisManager->FillNtupleDColumn(1, flagProcess);
-    analysisManager->FillNtupleDColumn(2, xp);
-    analysisManager->FillNtupleDColumn(3, yp);
-    analysisManager->FillNtupleDColumn(4, zp);
-    analysisManager->FillNtupleDColumn(5, step->GetTotalEnergyDeposit() / eV);
-
-    analysisManager->FillNtupleDColumn(
-      6, std::sqrt((x - xp) * (x - xp) + (y - yp) * (y - yp) + (z - zp) * (z - zp)));
-
-    analysisManager->FillNtupleDColumn(
-      7, (preStep->GetKineticEnergy() - postStep->GetKineticEnergy()) / eV);
+  fRunAction->GetStepBuffer().Add(step, flagParticle, flagProcess, weight);
+}
 
-    analysisManager->FillNtupleDColumn(8, preStep->GetKineticEnergy() / eV);
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-    analysisManager->FillNtupleDColumn(9, preStep->GetMomentumDirection()
-                                            * postStep->GetMomentumDirection());
+void SteppingAction::FillHistograms(const G4Step* step, G4int flagProcess, G4double weight)
+{
+  // Histograms are thread-local and merged by the analysis manager at the
+  // end of the run
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+
+  analysisManager->FillH1(0, flagProcess, weight);
+
+  const G4Track* track = step->GetTrack();
+  if (track->GetTrackID() == 1 && track->GetParentID() == 0
+      && track->GetCurrentStepNumber() == 1)
+  {
+    G4double kineticEnergy = 0.;
+    G4ThreeVector direction;
+    StepClassifier::PostStepChange(step, flagProcess, kineticEnergy, direction);
+    G4double cosTheta = step->GetPreStepPoint()->GetMomentumDirection().dot(direction);
+    analysisManager->FillH1(3, cosTheta, weight);
+  }
+}
 
-    analysisManager->FillNtupleIColumn(
-      10, G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID());
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-    analysisManager->FillNtupleIColumn(11, step->GetTrack()->GetTrackID());
+void SteppingAction::Profile(const G4Step* step, ProcessProfile& profile)
+{
+  const G4VProcess* process = step->GetPostStepPoint()->GetProcessDefinedStep();
+  StepClassifier& classifier = fRunAction->GetStepClassifier();
+
+  G4int flagParticle =
+    classifier.ParticleFlag(step->GetTrack()->GetDynamicParticle()->GetDefinition());
+  G4int index = ProcessProfile::kTransportation;
+  if (!classifier.IsTransportation(process)) {
+    index = classifier.ProcessFlag(flagParticle, process);
+    if (index < 0) index = ProcessProfile::kOtherProcess;
+  }
 
-    analysisManager->FillNtupleIColumn(12, step->GetTrack()->GetParentID());
+  profile.AddStep(flagParticle, index, step->GetTotalEnergyDeposit());
+  if (!profile.HasName(flagParticle, index)) {
+    profile.SetName(flagParticle, index, process->GetProcessName());
+  }
 
-    analysisManager->FillNtupleIColumn(13, step->GetTrack()->GetCurrentStepNumber());
+  // The CPU time since the previous step of this thread is attributed to
+  // this step, for one step out of N (the first step of an event is never
+  // timed, see ResetProfileTimer)
+  G4int period = fRunAction->GetProfileSamplingPeriod();
+  G4bool start = (++fProfileCounter % period == 0);
+  if (!fProfileTimed && !start) return;
 
-    analysisManager->AddNtupleRow();
+  G4double now = ThreadCpuTime();
+  if (fProfileTimed) {
+    profile.AddTime(flagParticle, index, (now - fProfileTime) * period);
   }
+  fProfileTimed = start;
+  fProfileTime = now;
 }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
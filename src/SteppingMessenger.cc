@@ -38,9 +38,33 @@
 
 #include "SteppingMessenger.hh"
 #include "SteppingAction.hh"
+#include "StepFilter.hh"
 
+#include "G4UIcmdWithAString.hh"
 #include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcommand.hh"
 #include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace
+{
+std::vector<G4int> ParseFlags(const G4String& list)
+{
+  std::vector<G4int> flags;
+  std::istringstream is(list);
+  G4int flag;
+  while (is >> flag) {
+    flags.push_back(flag);
+  }
+  return flags;
+}
+}  // namespace
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -54,6 +78,56 @@ SteppingMessenger::SteppingMessenger(SteppingAction* step) : fSteppingAction(ste
   fKillCmd->SetParameterName("choice", true);
   fKillCmd->SetRange("choice>=0");
   fKillCmd->SetDefaultValue(0);
+
+  fFilterDir = new G4UIdirectory("/step/filter/");
+  fFilterDir->SetGuidance("Selection of the recorded steps.");
+  fFilterDir->SetGuidance("All the rules set must be satisfied; without rules every step is");
+  fFilterDir->SetGuidance("recorded. The rules are applied from the next /run/beamOn.");
+
+  fParticleCmd = new G4UIcmdWithAString("/step/filter/particle", this);
+  fParticleCmd->SetGuidance("Record only the steps of these particle flags");
+  fParticleCmd->SetGuidance("(space separated list, see README for the numbering).");
+  fParticleCmd->SetParameterName("flags", false);
+  fParticleCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fProcessCmd = new G4UIcmdWithAString("/step/filter/process", this);
+  fProcessCmd->SetGuidance("Record only the steps of these process flags");
+  fProcessCmd->SetGuidance("(space separated list, see README for the numbering).");
+  fProcessCmd->SetParameterName("flags", false);
+  fProcessCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fEnergyCmd = new G4UIcommand("/step/filter/energy", this);
+  fEnergyCmd->SetGuidance("Record only the steps with a kinetic energy at the PreStepPoint");
+  fEnergyCmd->SetGuidance("in [min, max).");
+  auto minPrm = new G4UIparameter("min", 'd', false);
+  minPrm->SetParameterRange("min>=0.");
+  fEnergyCmd->SetParameter(minPrm);
+  auto maxPrm = new G4UIparameter("max", 'd', false);
+  maxPrm->SetParameterRange("max>0.");
+  fEnergyCmd->SetParameter(maxPrm);
+  auto energyUnitPrm = new G4UIparameter("unit", 's', true);
+  energyUnitPrm->SetDefaultValue("eV");
+  energyUnitPrm->SetParameterCandidates(
+    G4UIcommand::UnitsList(G4UIcommand::CategoryOf("eV")));
+  fEnergyCmd->SetParameter(energyUnitPrm);
+  fEnergyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBoxCmd = new G4UIcommand("/step/filter/box", this);
+  fBoxCmd->SetGuidance("Record only the steps ending in this box, given by two corners.");
+  fBoxCmd->SetGuidance("Each command adds a box; a step is kept if it ends in any of them.");
+  for (const char* name : {"x1", "y1", "z1", "x2", "y2", "z2"}) {
+    fBoxCmd->SetParameter(new G4UIparameter(name, 'd', false));
+  }
+  auto lengthUnitPrm = new G4UIparameter("unit", 's', true);
+  lengthUnitPrm->SetDefaultValue("nm");
+  lengthUnitPrm->SetParameterCandidates(
+    G4UIcommand::UnitsList(G4UIcommand::CategoryOf("nm")));
+  fBoxCmd->SetParameter(lengthUnitPrm);
+  fBoxCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/step/filter/clear", this);
+  fClearCmd->SetGuidance("Remove all the rules: every step is recorded.");
+  fClearCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -61,6 +135,12 @@ SteppingMessenger::SteppingMessenger(SteppingAction* step) : fSteppingAction(ste
 SteppingMessenger::~SteppingMessenger()
 {
   delete fKillCmd;
+  delete fParticleCmd;
+  delete fProcessCmd;
+  delete fEnergyCmd;
+  delete fBoxCmd;
+  delete fClearCmd;
+  delete fFilterDir;
   delete fStepDir;
 }
 
@@ -71,6 +151,37 @@ void SteppingMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
   if (command == fKillCmd) {
     fSteppingAction->SetKillStatus(fKillCmd->GetNewIntValue(newValue));
   }
+
+  if (command == fParticleCmd) {
+    fSteppingAction->GetStepFilter().SetParticles(ParseFlags(newValue));
+  }
+
+  if (command == fProcessCmd) {
+    fSteppingAction->GetStepFilter().SetProcesses(ParseFlags(newValue));
+  }
+
+  if (command == fEnergyCmd) {
+    G4double min, max;
+    G4String unit;
+    std::istringstream is(newValue);
+    is >> min >> max >> unit;
+    G4double value = G4UIcommand::ValueOf(unit);
+    fSteppingAction->GetStepFilter().SetEnergyWindow(min * value, max * value);
+  }
+
+  if (command == fBoxCmd) {
+    G4double x1, y1, z1, x2, y2, z2;
+    G4String unit;
+    std::istringstream is(newValue);
+    is >> x1 >> y1 >> z1 >> x2 >> y2 >> z2 >> unit;
+    G4double value = G4UIcommand::ValueOf(unit);
+    fSteppingAction->GetStepFilter().AddBox(G4ThreeVector(x1, y1, z1) * value,
+                                            G4ThreeVector(x2, y2, z2) * value);
+  }
+
+  if (command == fClearCmd) {
+    fSteppingAction->GetStepFilter().Clear();
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -38,47 +38,28 @@
 
 #include "TrackingAction.hh"
 
-#include "G4Alpha.hh"
+#include "RunAction.hh"
+#include "StepClassifier.hh"
+
 #include "G4AnalysisManager.hh"
-#include "G4DNAGenericIonsManager.hh"
-#include "G4Electron.hh"
-#include "G4Gamma.hh"
 #include "G4PhysicalConstants.hh"
-#include "G4Proton.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4Track.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-TrackingAction::TrackingAction() {}
+TrackingAction::TrackingAction(RunAction* runAction) : fRunAction(runAction) {}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void TrackingAction::PreUserTrackingAction(const G4Track* aTrack)
 {
-  G4double flagParticle = -1.;
+  G4double flagParticle;
   G4double x, y, z, dirx, diry, dirz;
 
-  G4ParticleDefinition* partDef = aTrack->GetDynamicParticle()->GetDefinition();
-
-  if (partDef == G4Gamma::GammaDefinition()) flagParticle = 0;
-
-  if (partDef == G4Electron::ElectronDefinition()) flagParticle = 1;
-
-  if (partDef == G4Proton::ProtonDefinition()) flagParticle = 2;
-
-  if (partDef == G4Alpha::AlphaDefinition()) flagParticle = 4;
-
-  G4DNAGenericIonsManager* instance;
-  instance = G4DNAGenericIonsManager::Instance();
-
-  if (partDef == instance->GetIon("hydrogen")) flagParticle = 3;
-
-  if (partDef == instance->GetIon("alpha+")) flagParticle = 5;
-
-  if (partDef == instance->GetIon("helium")) flagParticle = 6;
-
-  //
+  // Same particle numbering as in SteppingAction
+  flagParticle =
+    fRunAction->GetStepClassifier().ParticleFlag(aTrack->GetDynamicParticle()->GetDefinition());
 
   x = aTrack->GetPosition().x() / nanometer;
   y = aTrack->GetPosition().y() / nanometer;
@@ -88,21 +69,36 @@ void TrackingAction::PreUserTrackingAction(const G4Track* aTrack)
   diry = aTrack->GetMomentumDirection().y();
   dirz = aTrack->GetMomentumDirection().z();
 
-  // Call analysis manager
-  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
-
-  // Fill track information ntuple
-  analysisManager->FillNtupleDColumn(1, 0, flagParticle);
-  analysisManager->FillNtupleDColumn(1, 1, x);
-  analysisManager->FillNtupleDColumn(1, 2, y);
-  analysisManager->FillNtupleDColumn(1, 3, z);
-  analysisManager->FillNtupleDColumn(1, 4, dirx);
-  analysisManager->FillNtupleDColumn(1, 5, diry);
-  analysisManager->FillNtupleDColumn(1, 6, dirz);
-  analysisManager->FillNtupleDColumn(1, 7, aTrack->GetKineticEnergy() / eV);
-  analysisManager->FillNtupleIColumn(1, 8, aTrack->GetTrackID());
-  analysisManager->FillNtupleIColumn(1, 9, aTrack->GetParentID());
-  analysisManager->AddNtupleRow(1);
+  if (fRunAction->IsHistogramOutput()) {
+    // Electron and gamma spectra, in internal units (see RunAction::BookHistograms)
+    G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+    G4double weight = aTrack->GetWeight();
+    if (flagParticle == 1) analysisManager->FillH1(1, aTrack->GetKineticEnergy(), weight);
+    if (flagParticle == 0) analysisManager->FillH1(2, aTrack->GetKineticEnergy(), weight);
+    return;
+  }
+
+  EventSampler& sampler = fRunAction->GetEventSampler();
+  if (!sampler.IsEventRecorded()) return;
+
+  TrackRecord track;
+  track.flagParticle = (G4int)flagParticle;
+  track.x = x;
+  track.y = y;
+  track.z = z;
+  track.dirx = dirx;
+  track.diry = diry;
+  track.dirz = dirz;
+  track.kineticEnergy = aTrack->GetKineticEnergy() / eV;
+  track.trackID = aTrack->GetTrackID();
+  track.parentID = aTrack->GetParentID();
+
+  // Tracks of the reservoir sampling are written at the end of the run
+  if (sampler.IsHoldingEvents()) {
+    sampler.AddTrack(track);
+    return;
+  }
+  fRunAction->WriteTrack(track);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......